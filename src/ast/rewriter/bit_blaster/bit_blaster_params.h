@@ -19,12 +19,16 @@ Revision History:
 #ifndef BIT_BLASTER_PARAMS_H_
 #define BIT_BLASTER_PARAMS_H_
 
+#include<climits>
+
 struct bit_blaster_params {
     bool  m_bb_ext_gates;
     bool  m_bb_quantifiers;
+    unsigned m_bb_mul_tree_threshold;
     bit_blaster_params() :
         m_bb_ext_gates(false),
-        m_bb_quantifiers(false) {
+        m_bb_quantifiers(false),
+        m_bb_mul_tree_threshold(UINT_MAX) {
     }
 #if 0
     void register_params(ini_params & p) {
@@ -36,6 +40,7 @@ struct bit_blaster_params {
     void display(std::ostream & out) const {
         out << "m_bb_ext_gates=" << m_bb_ext_gates << std::endl;
         out << "m_bb_quantifiers=" << m_bb_quantifiers << std::endl;
+        out << "m_bb_mul_tree_threshold=" << m_bb_mul_tree_threshold << std::endl;
     }
 };
 
@@ -92,6 +92,13 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
     func_decl_ref_vector                     m_keys;
     expr_ref_vector                          m_values;
     unsigned_vector                          m_keyval_lim;
+    // results that survive cleanup, removed by pop together with the constants they depend on.
+    bool                                     m_term_cache;
+    obj_map<expr, expr*>                     m_term2bits;
+    expr_ref_vector                          m_term_keys;
+    expr_ref_vector                          m_term_values;
+    unsigned_vector                          m_term_lim;
+    static const unsigned                    max_cached_terms = 1 << 16;
 
     bool                                     m_blast_mul;
     bool                                     m_blast_add;
@@ -118,7 +125,10 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_out(m),
         m_bindings(m),
         m_keys(m),
-        m_values(m) {
+        m_values(m),
+        m_term_cache(false),
+        m_term_keys(m),
+        m_term_values(m) {
         updt_params(p);
     }
 
@@ -133,6 +143,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
         m_blast_full     = p.get_bool("blast_full", false);
         m_blast_quant    = p.get_bool("blast_quant", false);
         m_blaster.set_max_memory(m_max_memory);
+        m_blaster.set_mul_tree_threshold(p.get_uint("mul_tree_threshold", UINT_MAX));
     }
 
     bool rewrite_patterns() const { return true; }
@@ -160,6 +171,7 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
 
     void push() {
         m_keyval_lim.push_back(m_keys.size());
+        m_term_lim.push_back(m_term_keys.size());
     }
 
     unsigned get_num_scopes() const {
@@ -178,9 +190,45 @@ struct blaster_rewriter_cfg : public default_rewriter_cfg {
             m_keys.resize(lim);
             m_values.resize(lim);
             m_keyval_lim.resize(new_sz);
+            lim = m_term_lim[new_sz];
+            for (unsigned i = m_term_keys.size(); i > lim; ) {
+                --i;
+                m_term2bits.remove(m_term_keys.get(i));
+            }
+            m_term_keys.resize(lim);
+            m_term_values.resize(lim);
+            m_term_lim.resize(new_sz);
+        }
+    }
+
+    /**
+       \brief Drop all cached terms. Later pops then also remove the terms cached
+       for the scopes that remain, which only costs their reuse.
+    */
+    void reset_terms() {
+        m_term2bits.reset();
+        m_term_keys.reset();
+        m_term_values.reset();
+        for (unsigned & lim : m_term_lim)
+            lim = 0;
+    }
+
+    void save_term(expr * t, expr * r) {
+        if (!m_term2bits.contains(t)) {
+            m_term2bits.insert(t, r);
+            m_term_keys.push_back(t);
+            m_term_values.push_back(r);
         }
     }
 
+    bool get_subst(expr * s, expr * & t, proof * & t_pr) {
+        if (m_term_cache && m_term2bits.find(s, t)) {
+            t_pr = nullptr;
+            return true;
+        }
+        return false;
+    }
+
     template<typename V>
     app * mk_mkbv(V const & bits) {
         return m().mk_app(butil().get_family_id(), OP_MKBV, bits.size(), bits.c_ptr());
@@ -636,6 +684,37 @@ struct bit_blaster_rewriter::imp : public rewriter_tpl<blaster_rewriter_cfg> {
     void push() { m_cfg.push(); }
     void pop(unsigned s) { m_cfg.pop(s); }
     unsigned get_num_scopes() const { return m_cfg.get_num_scopes(); }
+
+    void operator()(expr * e, expr_ref & result, proof_ref & result_pr) {
+        rewriter_tpl<blaster_rewriter_cfg>::operator()(e, result, result_pr);
+        if (m_cfg.m_term_cache)
+            save_terms(e, result);
+    }
+
+    /**
+       \brief Move the results of the ground subterms of e from the rewriter cache,
+       which is reset by cleanup, to the term cache of m_cfg.
+    */
+    void save_terms(expr * e, expr * result) {
+        // terms of the base scope are never popped, so the cache is bounded by flushing it.
+        if (m_cfg.m_term_keys.size() >= blaster_rewriter_cfg::max_cached_terms)
+            m_cfg.reset_terms();
+        ptr_vector<expr> todo;
+        ast_mark visited;
+        todo.push_back(e);
+        while (!todo.empty()) {
+            expr * t = todo.back();
+            todo.pop_back();
+            if (!is_app(t) || visited.is_marked(t) || m_cfg.m_term2bits.contains(t) || !is_ground(t))
+                continue;
+            visited.mark(t, true);
+            expr * r = t == e ? result : get_cached(t);
+            if (r && r != t)
+                m_cfg.save_term(t, r);
+            for (expr * arg : *to_app(t))
+                todo.push_back(arg);
+        }
+    }
 };
 
 bit_blaster_rewriter::bit_blaster_rewriter(ast_manager & m, params_ref const & p):
@@ -667,6 +746,11 @@ unsigned bit_blaster_rewriter::get_num_steps() const {
     return m_imp->get_num_steps();
 }
 
+void bit_blaster_rewriter::set_term_cache(bool f) {
+    // cached results are returned without proofs.
+    m_imp->m_cfg.m_term_cache = f && !m().proofs_enabled();
+}
+
 void bit_blaster_rewriter::cleanup() {
     m_imp->cleanup();
 }
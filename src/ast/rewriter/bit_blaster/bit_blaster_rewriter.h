@@ -33,6 +33,8 @@ public:
     ast_manager & m() const;
     unsigned get_num_steps() const;
     void cleanup();
+    // Keep the bit-blasted terms across calls, until the scope that created them is popped.
+    void set_term_cache(bool f);
     obj_map<func_decl, expr*> const& const2bits() const; 
     void operator()(expr * e, expr_ref & result, proof_ref & result_proof);
     void push();
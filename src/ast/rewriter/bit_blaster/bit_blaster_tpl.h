@@ -38,6 +38,7 @@ protected:
     unsigned long long m_max_memory;
     bool               m_use_wtm; /* Wallace Tree Multiplier */
     bool               m_use_bcm; /* Booth Multiplier for constants */
+    unsigned           m_mul_tree_threshold; /* minimal width of Dadda tree multipliers */
     void checkpoint();
 
 public:
@@ -45,13 +46,18 @@ public:
         Cfg(cfg),
         m_max_memory(max_memory),
         m_use_wtm(use_wtm),
-        m_use_bcm(use_bcm) {
+        m_use_bcm(use_bcm),
+        m_mul_tree_threshold(UINT_MAX) {
     }
 
     void set_max_memory(unsigned long long max_memory) {
         m_max_memory = max_memory;
     }
 
+    void set_mul_tree_threshold(unsigned sz) {
+        m_mul_tree_threshold = sz;
+    }
+
     
     // Cfg required API
     ast_manager & m() const { return Cfg::m(); }
@@ -84,6 +90,9 @@ public:
     void mk_adder(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
     void mk_subtracter(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits, expr_ref & cout);
     void mk_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_dadda_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_partial_product(expr * a, expr * b, expr_ref & r);
+    bool lt_bits(unsigned sz, expr * const * a_bits, expr * const * b_bits) const;
     void mk_udiv_urem(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits, expr_ref_vector & r_bits);
     void mk_udiv(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & q_bits);
     void mk_urem(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & r_bits);
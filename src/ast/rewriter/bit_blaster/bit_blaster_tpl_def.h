@@ -184,7 +184,13 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
         return;
     }
     out_bits.reset();
-    if (!m_use_wtm) {
+    if (!m_use_wtm && sz >= m_mul_tree_threshold) {
+        // a*b and b*a produce the same circuit, so their gates are shared.
+        if (lt_bits(sz, b_bits, a_bits))
+            std::swap(a_bits, b_bits);
+        mk_dadda_multiplier(sz, a_bits, b_bits, out_bits);
+    }
+    else if (!m_use_wtm) {
 #if 0
     static unsigned counter = 0;
     counter++;
@@ -330,6 +336,102 @@ void bit_blaster_tpl<Cfg>::mk_multiplier(unsigned sz, expr * const * a_bits, exp
 }
 
 
+/**
+   \brief Return true if the bits of a precede the bits of b in the order of their ids.
+*/
+template<typename Cfg>
+bool bit_blaster_tpl<Cfg>::lt_bits(unsigned sz, expr * const * a_bits, expr * const * b_bits) const {
+    for (unsigned i = 0; i < sz; i++) {
+        if (a_bits[i] != b_bits[i])
+            return a_bits[i]->get_id() < b_bits[i]->get_id();
+    }
+    return false;
+}
+
+/**
+   \brief Partial product a and b. The arguments are ordered by id, so that
+   multipliers with common operands share their partial products.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_partial_product(expr * a, expr * b, expr_ref & r) {
+    if (a->get_id() > b->get_id())
+        std::swap(a, b);
+    mk_and(a, b, r);
+}
+
+/**
+   \brief Dadda tree multiplier.
+
+   The partial products are kept in columns of bits of equal weight. The columns
+   are compressed by full and half adders in stages of decreasing maximal height
+   (..., 9, 6, 4, 3, 2), and the two remaining rows are added by a ripple carry
+   adder. Only the sz least significant columns are built.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_dadda_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
+    SASSERT(sz > 0);
+    vector<expr_ref_vector> cols;
+    cols.resize(sz, expr_ref_vector(m()));
+    unsigned max_height = 0;
+    expr_ref t(m());
+    for (unsigned k = 0; k < sz; k++) {
+        for (unsigned j = 0; j <= k; j++) {
+            mk_partial_product(a_bits[j], b_bits[k - j], t);
+            if (!m().is_false(t))
+                cols[k].push_back(t);
+        }
+        max_height = std::max(max_height, cols[k].size());
+    }
+
+    unsigned_vector heights;
+    for (unsigned d = 2; d < max_height; d = (3 * d) / 2)
+        heights.push_back(d);
+    expr_ref sum(m()), carry(m());
+    unsigned s = heights.size();
+    while (true) {
+        checkpoint();
+        // the pass of height 2 is repeated until every column has at most two bits.
+        unsigned target = s > 0 ? heights[--s] : 2;
+        bool reduced = true;
+        for (unsigned k = 0; k < sz; k++) {
+            expr_ref_vector & col = cols[k];
+            expr_ref_vector new_col(m());
+            unsigned i = 0;
+            while (col.size() - i + new_col.size() > target && col.size() - i >= 2) {
+                bool full = col.size() - i + new_col.size() - target >= 2 && col.size() - i >= 3;
+                bool last = k + 1 == sz;
+                if (full && last)
+                    mk_xor3(col.get(i), col.get(i+1), col.get(i+2), sum);
+                else if (full)
+                    mk_full_adder(col.get(i), col.get(i+1), col.get(i+2), sum, carry);
+                else if (last)
+                    mk_xor(col.get(i), col.get(i+1), sum);
+                else
+                    mk_half_adder(col.get(i), col.get(i+1), sum, carry);
+                i += full ? 3 : 2;
+                new_col.push_back(sum);
+                if (!last)
+                    cols[k+1].push_back(carry);
+            }
+            for (; i < col.size(); i++)
+                new_col.push_back(col.get(i));
+            col.swap(new_col);
+            if (col.size() > 2)
+                reduced = false;
+        }
+        if (reduced)
+            break;
+    }
+
+    expr_ref_vector row1(m()), row2(m());
+    for (unsigned k = 0; k < sz; k++) {
+        SASSERT(cols[k].size() <= 2);
+        row1.push_back(cols[k].empty() ? m().mk_false() : cols[k].get(0));
+        row2.push_back(cols[k].size() < 2 ? m().mk_false() : cols[k].get(1));
+    }
+    mk_adder(sz, row1.c_ptr(), row2.c_ptr(), out_bits);
+}
+
 template<typename Cfg>
 void bit_blaster_tpl<Cfg>::mk_umul_no_overflow(unsigned sz, expr * const * a_bits,  expr * const * b_bits, expr_ref & result) {
     SASSERT(sz > 0);
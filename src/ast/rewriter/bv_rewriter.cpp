@@ -57,9 +57,102 @@ void bv_rewriter::get_param_descrs(param_descrs & r) {
 #endif
 }
 
+/**
+   \brief Read a numeral that fits in 64 bits without copying its rational.
+*/
+bool bv_rewriter::is_numeral64(expr * n, uint64_t & v) const {
+    if (!m_util.is_numeral(n))
+        return false;
+    rational const & r = to_app(n)->get_decl()->get_parameter(0).get_rational();
+    if (!r.is_uint64())
+        return false;
+    v = r.get_uint64();
+    return true;
+}
+
+/**
+   \brief Constant folding for bit-vectors of width at most 64 using machine arithmetic.
+   Return BR_FAILED if some argument is not a numeral, the operator is not handled,
+   or the width exceeds 64; the generic rules then apply.
+*/
+br_status bv_rewriter::mk_bv64_core(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result) {
+    decl_kind k = f->get_decl_kind();
+    switch (k) {
+    case OP_BADD: case OP_BSUB: case OP_BMUL: case OP_BNEG:
+    case OP_BAND: case OP_BOR: case OP_BXOR: case OP_BNOT:
+    case OP_BNAND: case OP_BNOR: case OP_BXNOR:
+    case OP_BUDIV_I: case OP_BUREM_I:
+    case OP_BSHL: case OP_BLSHR: case OP_BASHR:
+    case OP_ULEQ: case OP_UGEQ: case OP_ULT: case OP_UGT:
+        break;
+    default:
+        return BR_FAILED;
+    }
+    unsigned sz = get_bv_size(args[0]);
+    if (sz > 64 || sz == 0)
+        return BR_FAILED;
+    uint64_t mask = sz == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << sz) - 1;
+    uint64_t a, b;
+    if (!is_numeral64(args[0], a))
+        return BR_FAILED;
+    a &= mask;
+    if (num_args == 1) {
+        switch (k) {
+        case OP_BNEG: a = 0 - a; break;
+        case OP_BNOT: a = ~a; break;
+        case OP_BADD: case OP_BMUL: case OP_BAND: case OP_BOR: case OP_BXOR: break;
+        default: return BR_FAILED;
+        }
+    }
+    for (unsigned i = 1; i < num_args; ++i) {
+        if (!is_numeral64(args[i], b))
+            return BR_FAILED;
+        b &= mask;
+        bool binary = num_args == 2;
+        switch (k) {
+        case OP_BADD: a += b; break;
+        case OP_BMUL: a *= b; break;
+        case OP_BAND: a &= b; break;
+        case OP_BOR:  a |= b; break;
+        case OP_BXOR: a ^= b; break;
+        case OP_BSUB:  if (!binary) return BR_FAILED; a -= b; break;
+        case OP_BNAND: if (!binary) return BR_FAILED; a = ~(a & b); break;
+        case OP_BNOR:  if (!binary) return BR_FAILED; a = ~(a | b); break;
+        case OP_BXNOR: if (!binary) return BR_FAILED; a = ~(a ^ b); break;
+        case OP_BUDIV_I: if (!binary) return BR_FAILED; a = b == 0 ? mask : a / b; break;
+        case OP_BUREM_I: if (!binary) return BR_FAILED; a = b == 0 ? a : a % b; break;
+        case OP_BSHL:  if (!binary) return BR_FAILED; a = b >= sz ? 0 : a << b; break;
+        case OP_BLSHR: if (!binary) return BR_FAILED; a = b >= sz ? 0 : a >> b; break;
+        case OP_BASHR: {
+            if (!binary) return BR_FAILED;
+            bool neg = ((a >> (sz - 1)) & 1) != 0;
+            if (b >= sz)
+                a = neg ? mask : 0;
+            else
+                a = neg ? ~((~a & mask) >> b) : a >> b;
+            break;
+        }
+        case OP_ULEQ: case OP_UGEQ: case OP_ULT: case OP_UGT: {
+            if (!binary) return BR_FAILED;
+            bool r = k == OP_ULEQ ? a <= b : k == OP_UGEQ ? a >= b : k == OP_ULT ? a < b : a > b;
+            result = r ? m().mk_true() : m().mk_false();
+            return BR_DONE;
+        }
+        default:
+            return BR_FAILED;
+        }
+    }
+    result = mk_numeral(numeral(a & mask, numeral::ui64()), sz);
+    return BR_DONE;
+}
+
 br_status bv_rewriter::mk_app_core(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result) {
     SASSERT(f->get_family_id() == get_fid());
 
+    if (num_args > 0 && is_numeral(args[0]) && mk_bv64_core(f, num_args, args, result) == BR_DONE) {
+        return BR_DONE;
+    }
+
     switch(f->get_decl_kind()) {
     case OP_BIT0: SASSERT(num_args == 0); result = m_util.mk_numeral(0, 1); return BR_DONE;
     case OP_BIT1: SASSERT(num_args == 0); result = m_util.mk_numeral(1, 1); return BR_DONE;
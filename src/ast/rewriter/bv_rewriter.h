@@ -70,6 +70,9 @@ class bv_rewriter : public poly_rewriter<bv_rewriter_core> {
 
     bool is_zero_bit(expr * x, unsigned idx);
 
+    bool is_numeral64(expr * n, uint64_t & v) const;
+    br_status mk_bv64_core(func_decl * f, unsigned num_args, expr * const * args, expr_ref & result);
+
     br_status mk_ule(expr * a, expr * b, expr_ref & result);
     br_status mk_uge(expr * a, expr * b, expr_ref & result);
     br_status mk_ult(expr * a, expr * b, expr_ref & result);
@@ -190,7 +190,7 @@ public:
     }*/
 };
 
-re2automaton::re2automaton(ast_manager& m): m(m), u(m), bv(m), m_ba(nullptr), m_sa(nullptr) {}
+re2automaton::re2automaton(ast_manager& m): m(m), u(m), bv(m), m_ba(nullptr), m_sa(nullptr), m_cache_pinned(m) {}
 
 re2automaton::~re2automaton() {}
 
@@ -198,6 +198,10 @@ void re2automaton::set_solver(expr_solver* solver) {
     m_solver = solver;
     m_ba = alloc(sym_expr_boolean_algebra, m, *solver);
     m_sa = alloc(symbolic_automata_t, sm, *m_ba.get());
+    // complements and intersections are only translated when there is a solver.
+    m_cache.reset();
+    m_cache_auts.reset();
+    m_cache_pinned.reset();
 }
 
 eautomaton* re2automaton::mk_product(eautomaton* a1, eautomaton* a2) {
@@ -205,16 +209,27 @@ eautomaton* re2automaton::mk_product(eautomaton* a1, eautomaton* a2) {
 }
 
 eautomaton* re2automaton::operator()(expr* e) { 
-    eautomaton* r = re2aut(e); 
+    eautomaton* r = nullptr;
+    if (m_cache.find(e, r)) {
+        return r ? r->clone() : nullptr;
+    }
+    r = re2aut(e); 
     if (r) {        
         r->compress(); 
         bool_rewriter br(m);
         TRACE("seq", display_expr1 disp(m); r->display(tout, disp););
     }
+    if (m_cache.size() < max_cache_size) {
+        m_cache_pinned.push_back(e);
+        m_cache.insert(e, r);
+        if (r) {
+            m_cache_auts.push_back(r);
+            r = r->clone();
+        }
+    }
     return r;
 } 
 
-
 eautomaton* re2automaton::re2aut(expr* e) {
     SASSERT(u.is_re(e));
     expr *e0, *e1, *e2;
@@ -2048,6 +2063,179 @@ bool seq_rewriter::is_epsilon(expr* e) const {
     return m_util.re.is_to_re(e, e1) && m_util.str.is_empty(e1);
 }
 
+expr* seq_rewriter::mk_re_epsilon(sort* re_sort) {
+    sort* seq_sort = nullptr;
+    VERIFY(m_util.is_re(re_sort, seq_sort));
+    return m_util.re.mk_to_re(m_util.str.mk_empty(seq_sort));
+}
+
+expr* seq_rewriter::mk_re_union0(expr* a, expr* b) {
+    if (m_util.re.is_empty(a) || a == b) return b;
+    if (m_util.re.is_empty(b)) return a;
+    return m_util.re.mk_union(a, b);
+}
+
+expr* seq_rewriter::mk_re_inter0(expr* a, expr* b) {
+    if (m_util.re.is_empty(a) || a == b) return a;
+    if (m_util.re.is_empty(b)) return b;
+    return m_util.re.mk_inter(a, b);
+}
+
+expr* seq_rewriter::mk_re_concat0(expr* a, expr* b) {
+    if (m_util.re.is_empty(a) || is_epsilon(b)) return a;
+    if (m_util.re.is_empty(b) || is_epsilon(a)) return b;
+    return m_util.re.mk_concat(a, b);
+}
+
+lbool seq_rewriter::is_re_nullable(expr* r) {
+    expr* r1, *r2;
+    unsigned lo, hi;
+    zstring s;
+    if (m_util.re.is_to_re(r, r1)) {
+        if (m_util.str.is_empty(r1)) return l_true;
+        if (m_util.str.is_string(r1, s)) return s.length() == 0 ? l_true : l_false;
+        return m_util.str.is_unit(r1) ? l_false : l_undef;
+    }
+    if (m_util.re.is_empty(r) || m_util.re.is_range(r) || m_util.re.is_full_char(r)) {
+        return l_false;
+    }
+    if (m_util.re.is_full_seq(r) || m_util.re.is_star(r) || m_util.re.is_opt(r)) {
+        return l_true;
+    }
+    if (m_util.re.is_plus(r, r1)) {
+        return is_re_nullable(r1);
+    }
+    if (m_util.re.is_complement(r, r1)) {
+        return ~is_re_nullable(r1);
+    }
+    if (m_util.re.is_union(r, r1, r2)) {
+        lbool n1 = is_re_nullable(r1);
+        return n1 == l_true ? l_true : (n1 == l_false ? is_re_nullable(r2) : (is_re_nullable(r2) == l_true ? l_true : l_undef));
+    }
+    if (m_util.re.is_intersection(r, r1, r2) || m_util.re.is_concat(r, r1, r2)) {
+        lbool n1 = is_re_nullable(r1);
+        return n1 == l_false ? l_false : (n1 == l_true ? is_re_nullable(r2) : (is_re_nullable(r2) == l_false ? l_false : l_undef));
+    }
+    if (m_util.re.is_loop(r, r1, lo, hi) || m_util.re.is_loop(r, r1, lo)) {
+        return lo == 0 ? l_true : is_re_nullable(r1);
+    }
+    return l_undef;
+}
+
+/**
+   The derivative of each sub-expression is cached, so the states of the
+   automaton of r are materialized only as far as they are reached by the
+   characters consumed.
+*/
+expr* seq_rewriter::re_derivative(unsigned ch, expr* r) {
+    expr* result = nullptr;
+    re_char key(r, ch);
+    if (m_derivatives.find(key, result)) {
+        return result;
+    }
+    sort* re_sort = m().get_sort(r);
+    expr* r1, *r2;
+    unsigned lo, hi;
+    zstring s, s_lo, s_hi;
+    if (m_util.re.is_empty(r)) {
+        result = r;
+    }
+    else if (m_util.re.is_to_re(r, r1)) {
+        if (m_util.str.is_empty(r1)) {
+            result = m_util.re.mk_empty(re_sort);
+        }
+        else if (m_util.str.is_string(r1, s)) {
+            if (s.length() == 0 || s[0] != ch) {
+                result = m_util.re.mk_empty(re_sort);
+            }
+            else {
+                result = m_util.re.mk_to_re(m_util.str.mk_string(s.extract(1, s.length() - 1)));
+            }
+        }
+    }
+    else if (m_util.re.is_range(r, r1, r2)) {
+        if (m_util.str.is_string(r1, s_lo) && m_util.str.is_string(r2, s_hi) &&
+            s_lo.length() == 1 && s_hi.length() == 1) {
+            result = (s_lo[0] <= ch && ch <= s_hi[0]) ? mk_re_epsilon(re_sort) : m_util.re.mk_empty(re_sort);
+        }
+    }
+    else if (m_util.re.is_full_char(r)) {
+        result = mk_re_epsilon(re_sort);
+    }
+    else if (m_util.re.is_full_seq(r)) {
+        result = r;
+    }
+    else if (m_util.re.is_union(r, r1, r2)) {
+        expr* d1 = re_derivative(ch, r1);
+        expr* d2 = d1 ? re_derivative(ch, r2) : nullptr;
+        if (d2) result = mk_re_union0(d1, d2);
+    }
+    else if (m_util.re.is_intersection(r, r1, r2)) {
+        expr* d1 = re_derivative(ch, r1);
+        expr* d2 = d1 ? re_derivative(ch, r2) : nullptr;
+        if (d2) result = mk_re_inter0(d1, d2);
+    }
+    else if (m_util.re.is_complement(r, r1)) {
+        expr* d1 = re_derivative(ch, r1);
+        if (d1) result = m_util.re.mk_complement(d1);
+    }
+    else if (m_util.re.is_concat(r, r1, r2)) {
+        lbool n1 = is_re_nullable(r1);
+        expr* d1 = n1 == l_undef ? nullptr : re_derivative(ch, r1);
+        if (d1) {
+            result = mk_re_concat0(d1, r2);
+            if (n1 == l_true) {
+                expr* d2 = re_derivative(ch, r2);
+                result = d2 ? mk_re_union0(result, d2) : nullptr;
+            }
+        }
+    }
+    else if (m_util.re.is_star(r, r1)) {
+        expr* d1 = re_derivative(ch, r1);
+        if (d1) result = mk_re_concat0(d1, r);
+    }
+    else if (m_util.re.is_plus(r, r1)) {
+        expr* d1 = re_derivative(ch, r1);
+        if (d1) result = mk_re_concat0(d1, m_util.re.mk_star(r1));
+    }
+    else if (m_util.re.is_opt(r, r1)) {
+        result = re_derivative(ch, r1);
+    }
+    else if (m_util.re.is_loop(r, r1, lo, hi)) {
+        expr* d1 = re_derivative(ch, r1);
+        if (d1 && hi == 0) {
+            result = m_util.re.mk_empty(re_sort);
+        }
+        else if (d1) {
+            result = mk_re_concat0(d1, m_util.re.mk_loop(r1, lo > 0 ? lo - 1 : 0, hi - 1));
+        }
+    }
+    else if (m_util.re.is_loop(r, r1, lo)) {
+        expr* d1 = re_derivative(ch, r1);
+        if (d1) result = mk_re_concat0(d1, m_util.re.mk_loop(r1, lo > 0 ? lo - 1 : 0));
+    }
+    if (result) {
+        m_derivative_trail.push_back(r);
+        m_derivative_trail.push_back(result);
+        m_derivatives.insert(key, result);
+    }
+    return result;
+}
+
+bool seq_rewriter::mk_re_derivative(unsigned ch, expr* r, expr_ref& result) {
+    // the cache is only flushed between top-level calls, where no derivative is held by it alone.
+    if (m_derivatives.size() > max_derivatives) {
+        m_derivatives.reset();
+        m_derivative_trail.reset();
+    }
+    expr* d = re_derivative(ch, r);
+    if (!d) {
+        return false;
+    }
+    result = d;
+    return true;
+}
+
 bool seq_rewriter::is_subsequence(unsigned szl, expr* const* l, unsigned szr, expr* const* r, 
                                   expr_ref_vector& lhs, expr_ref_vector& rhs, bool& is_sat) {
     is_sat = true;
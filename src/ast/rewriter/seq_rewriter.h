@@ -24,6 +24,9 @@ Notes:
 #include "ast/rewriter/rewriter_types.h"
 #include "util/params.h"
 #include "util/lbool.h"
+#include "util/obj_hashtable.h"
+#include "util/scoped_ptr_vector.h"
+#include "util/map.h"
 #include "math/automata/automaton.h"
 #include "math/automata/symbolic_automata.h"
 
@@ -81,6 +84,12 @@ class re2automaton {
     scoped_ptr<expr_solver>         m_solver;
     scoped_ptr<boolean_algebra_t>   m_ba;
     scoped_ptr<symbolic_automata_t> m_sa;
+    // regular expression -> compressed automaton
+    obj_map<expr, eautomaton*>      m_cache;
+    scoped_ptr_vector<eautomaton>   m_cache_auts;
+    expr_ref_vector                 m_cache_pinned;
+
+    static const unsigned max_cache_size = 1024;
 
     eautomaton* re2aut(expr* e);
     eautomaton* seq2aut(expr* e);
@@ -146,10 +155,24 @@ class seq_rewriter {
     bool is_epsilon(expr* e) const;
     void split_units(expr_ref_vector& lhs, expr_ref_vector& rhs);
 
+    // Brzozowski derivatives of regular expressions, hash-consed by (regex, character).
+    typedef std::pair<expr*, unsigned> re_char;
+    typedef map<re_char, expr*, pair_hash<obj_ptr_hash<expr>, unsigned_hash>, default_eq<re_char> > derivative_cache;
+    derivative_cache m_derivatives;
+    expr_ref_vector  m_derivative_trail;
+
+    static const unsigned max_derivatives = 4096;
+
+    expr* re_derivative(unsigned ch, expr* r);
+    expr* mk_re_epsilon(sort* re_sort);
+    expr* mk_re_union0(expr* a, expr* b);
+    expr* mk_re_inter0(expr* a, expr* b);
+    expr* mk_re_concat0(expr* a, expr* b);
+
 
 public:    
     seq_rewriter(ast_manager & m, params_ref const & p = params_ref()):
-        m_util(m), m_autil(m), m_re2aut(m), m_es(m), m_lhs(m), m_rhs(m) {
+        m_util(m), m_autil(m), m_re2aut(m), m_es(m), m_lhs(m), m_rhs(m), m_derivative_trail(m) {
     }
     ast_manager & m() const { return m_util.get_manager(); }
     family_id get_fid() const { return m_util.get_family_id(); }
@@ -169,6 +192,18 @@ public:
 
     void add_seqs(expr_ref_vector const& ls, expr_ref_vector const& rs, expr_ref_vector& lhs, expr_ref_vector& rhs);
 
+    /**
+       \brief Set result to the derivative of the regular expression r with respect to the character ch,
+       that is, a regular expression for { w | ch w in r }.
+       Return false if r contains constructs that are not handled (non-ground or symbolic bounds).
+    */
+    bool mk_re_derivative(unsigned ch, expr* r, expr_ref& result);
+
+    /**
+       \brief Determine whether the empty sequence is accepted by r.
+    */
+    lbool is_re_nullable(expr* r);
+
 
 };
 
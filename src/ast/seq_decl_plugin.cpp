@@ -123,78 +123,126 @@ static bool is_escape_char(char const *& s, unsigned& result) {
     return false;
 }
 
-zstring::zstring(encoding enc): m_encoding(enc) {}
+zstring::zstring(encoding enc): 
+    m_rep(nullptr), m_offset(0), m_length(0), m_hash(0), m_hash_valid(false), m_encoding(enc) {}
 
-zstring::zstring(char const* s, encoding enc): m_encoding(enc) {
+zstring::zstring(char const* s, encoding enc): 
+    m_rep(nullptr), m_offset(0), m_length(0), m_hash(0), m_hash_valid(false), m_encoding(enc) {
     unsigned mask = 0xFF; // TBD for UTF
+    buffer<unsigned> chars;
     while (*s) {
         unsigned ch;
         if (is_escape_char(s, ch)) {
-            m_buffer.push_back(ch & mask);
+            chars.push_back(ch & mask);
         }
         else {
-            m_buffer.push_back(*s & mask);
+            chars.push_back(*s & mask);
             ++s;
         }
     }
+    init(chars.size(), chars.c_ptr());
 }
 
-zstring::zstring(zstring const& other) {
-    m_buffer = other.m_buffer;
-    m_encoding = other.m_encoding;
+zstring::zstring(zstring const& other):
+    m_rep(other.m_rep), 
+    m_offset(other.m_offset), 
+    m_length(other.m_length), 
+    m_hash(other.m_hash), 
+    m_hash_valid(other.m_hash_valid), 
+    m_encoding(other.m_encoding) {
+    inc_ref();
 }
 
-zstring::zstring(unsigned sz, unsigned const* s, encoding enc) {
-    m_buffer.append(sz, s);
-    m_encoding = enc;
+zstring::zstring(unsigned sz, unsigned const* s, encoding enc):
+    m_rep(nullptr), m_offset(0), m_length(0), m_hash(0), m_hash_valid(false), m_encoding(enc) {
+    init(sz, s);
 }
 
-zstring::zstring(unsigned num_bits, bool const* ch) {
+zstring::zstring(unsigned num_bits, bool const* ch):
+    m_rep(nullptr), m_offset(0), m_length(0), m_hash(0), m_hash_valid(false) {
     SASSERT(num_bits == 8 || num_bits == 16);
     m_encoding = (num_bits == 8)?ascii:unicode;
     unsigned n = 0;
     for (unsigned i = 0; i < num_bits; ++i) {
         n |= (((unsigned)ch[i]) << i);
     }
-    m_buffer.push_back(n);
+    init(1, &n);
+}
+
+zstring::zstring(unsigned ch, encoding enc):
+    m_rep(nullptr), m_offset(0), m_length(0), m_hash(0), m_hash_valid(false), m_encoding(enc) {
+    ch &= ((enc == ascii)?0x000000FF:0x0000FFFF);
+    init(1, &ch);
+}
+
+void zstring::init(unsigned sz, unsigned const* s) {
+    SASSERT(m_rep == nullptr);
+    if (sz == 0)
+        return;
+    m_rep = static_cast<rep*>(memory::allocate(sizeof(rep) + (sz - 1) * sizeof(unsigned)));
+    m_rep->m_ref_count = 1;
+    m_rep->m_size = sz;
+    memcpy(m_rep->m_data, s, sz * sizeof(unsigned));
+    m_offset = 0;
+    m_length = sz;
 }
 
-zstring::zstring(unsigned ch, encoding enc) {
-    m_encoding = enc;
-    m_buffer.push_back(ch & ((enc == ascii)?0x000000FF:0x0000FFFF));
+void zstring::dec_ref() {
+    if (m_rep && --m_rep->m_ref_count == 0)
+        memory::deallocate(m_rep);
+    m_rep = nullptr;
 }
 
 zstring& zstring::operator=(zstring const& other) {
+    if (this == &other)
+        return *this;
+    const_cast<zstring&>(other).inc_ref();
+    dec_ref();
+    m_rep = other.m_rep;
+    m_offset = other.m_offset;
+    m_length = other.m_length;
+    m_hash = other.m_hash;
+    m_hash_valid = other.m_hash_valid;
     m_encoding = other.m_encoding;
-    m_buffer.reset();
-    m_buffer.append(other.m_buffer);
     return *this;
 }
 
+unsigned zstring::hash() const {
+    if (!m_hash_valid) {
+        m_hash = string_hash(reinterpret_cast<char const*>(data()), m_length * sizeof(unsigned), 17);
+        m_hash_valid = true;
+    }
+    return m_hash;
+}
+
 zstring zstring::replace(zstring const& src, zstring const& dst) const {
-    zstring result(m_encoding);
     if (length() < src.length()) {
         return zstring(*this);
     }
     if (src.length() == 0) {
         return dst + zstring(*this);
     }
+    buffer<unsigned> result;
+    unsigned const* chars = data();
     bool found = false;
     for (unsigned i = 0; i < length(); ++i) {
         bool eq = !found && i + src.length() <= length();
         for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
+            eq = chars[i+j] == src[j];
         }
         if (eq) {
-            result.m_buffer.append(dst.m_buffer);
+            result.append(dst.length(), dst.data());
             found = true;
             i += src.length() - 1;
         }
         else {
-            result.m_buffer.push_back(m_buffer[i]);
+            result.push_back(chars[i]);
         }
     }
-    return result;
+    if (!found) {
+        return zstring(*this);
+    }
+    return zstring(result.size(), result.c_ptr(), m_encoding);
 }
 
 static const char esc_table[32][6] =
@@ -205,8 +253,8 @@ static const char esc_table[32][6] =
 std::string zstring::encode() const {
     SASSERT(m_encoding == ascii);
     std::ostringstream strm;
-    for (unsigned i = 0; i < m_buffer.size(); ++i) {
-        unsigned char ch = m_buffer[i];
+    for (unsigned i = 0; i < length(); ++i) {
+        unsigned char ch = (*this)[i];
         if (0 <= ch && ch < 32) {
             strm << esc_table[ch];
         }
@@ -227,7 +275,7 @@ bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool suffix = true;
     for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
+        suffix = (*this)[length()-i-1] == other[other.length()-i-1];
     }
     return suffix;
 }
@@ -236,7 +284,7 @@ bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
     bool prefix = true;
     for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
+        prefix = (*this)[i] == other[i];
     }
     return prefix;
 }
@@ -248,7 +296,7 @@ bool zstring::contains(zstring const& other) const {
     for (unsigned i = 0; !cont && i <= last; ++i) {
         cont = true;
         for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
+            cont = other[j] == (*this)[j+i];
         }
     }
     return cont;
@@ -263,7 +311,7 @@ int zstring::indexof(zstring const& other, int offset) const {
     for (unsigned i = static_cast<unsigned>(offset); i <= last; ++i) {
         bool prefix = true;
         for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
+            prefix = (*this)[i + j] == other[j];
         }
         if (prefix) {
             return static_cast<int>(i);
@@ -273,20 +321,32 @@ int zstring::indexof(zstring const& other, int offset) const {
 }
 
 zstring zstring::extract(int offset, int len) const {
-    zstring result(m_encoding);
     SASSERT(0 <= offset && 0 <= len);
+    zstring result(m_encoding);
     int last = std::min(offset+len, static_cast<int>(length()));
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
+    if (offset >= last) {
+        return result;
     }
+    // share the characters of this string
+    result.m_rep = m_rep;
+    result.m_offset = m_offset + offset;
+    result.m_length = last - offset;
+    result.inc_ref();
     return result;
 }
 
 zstring zstring::operator+(zstring const& other) const {
     SASSERT(m_encoding == other.m_encoding);
-    zstring result(*this);
-    result.m_buffer.append(other.m_buffer);
-    return result;
+    if (other.empty()) {
+        return *this;
+    }
+    if (empty()) {
+        return other;
+    }
+    buffer<unsigned> result;
+    result.append(length(), data());
+    result.append(other.length(), other.data());
+    return zstring(result.size(), result.c_ptr(), m_encoding);
 }
 
 bool zstring::operator==(const zstring& other) const {
@@ -294,14 +354,19 @@ bool zstring::operator==(const zstring& other) const {
     if (length() != other.length()) {
         return false;
     }
+    if (m_rep == other.m_rep && m_offset == other.m_offset) {
+        return true;
+    }
+    if (m_hash_valid && other.m_hash_valid && m_hash != other.m_hash) {
+        return false;
+    }
+    unsigned const* xs = data();
+    unsigned const* ys = other.data();
     for (unsigned i = 0; i < length(); ++i) {
-        unsigned Xi = m_buffer[i];
-        unsigned Yi = other[i];
-        if (Xi != Yi) {
+        if (xs[i] != ys[i]) {
             return false;
         }
     }
-
     return true;
 }
 
@@ -841,6 +906,28 @@ void seq_decl_plugin::get_sort_names(svector<builtin_name> & sort_names, symbol
     sort_names.push_back(builtin_name("StringSequence", _STRING_SORT));
 }
 
+static const unsigned max_cached_strings = 65536;
+
+template<typename M, typename K, typename V>
+static void insert_cached(M* maps, K const& k, V const& v) {
+    if (maps[0].size() >= max_cached_strings) {
+        maps[1].swap(maps[0]);
+        maps[0].reset();
+    }
+    maps[0].insert(k, v);
+}
+
+template<typename M, typename K, typename V>
+static bool find_cached(M* maps, K const& k, V& v) {
+    if (maps[0].find(k, v)) 
+        return true;
+    if (maps[1].find(k, v)) {
+        insert_cached(maps, k, v);
+        return true;
+    }
+    return false;
+}
+
 app* seq_decl_plugin::mk_string(symbol const& s) {
     parameter param(s);
     func_decl* f = m_manager->mk_const_decl(m_stringc_sym, m_string,
@@ -849,13 +936,29 @@ app* seq_decl_plugin::mk_string(symbol const& s) {
 }
 
 app* seq_decl_plugin::mk_string(zstring const& s) {
-    symbol sym(s.encode().c_str());
+    symbol sym;
+    if (!find_cached(m_zstring2sym, s, sym)) {
+        sym = symbol(s.encode().c_str());
+        // the key should not retain the characters of a larger string that s is a slice of.
+        buffer<unsigned> chars;
+        for (unsigned i = 0; i < s.length(); ++i) 
+            chars.push_back(s[i]);
+        insert_cached(m_zstring2sym, zstring(chars.size(), chars.c_ptr(), s.get_encoding()), sym);
+    }
     parameter param(sym);
     func_decl* f = m_manager->mk_const_decl(m_stringc_sym, m_string,
                                             func_decl_info(m_family_id, OP_STRING_CONST, 1, &param));
     return m_manager->mk_const(f);
 }
 
+zstring seq_decl_plugin::get_zstring(symbol const& sym) {
+    zstring s;
+    if (!find_cached(m_sym2zstring, sym, s)) {
+        s = zstring(sym.bare_str());
+        insert_cached(m_sym2zstring, sym, s);
+    }
+    return s;
+}
 
 bool seq_decl_plugin::is_value(app* e) const {
     while (true) {
@@ -947,7 +1050,7 @@ app*  seq_util::str::mk_char(char ch) {
 
 bool seq_util::str::is_string(expr const* n, zstring& s) const {
     if (is_string(n)) {
-        s = zstring(to_app(n)->get_decl()->get_parameter(0).get_symbol().bare_str());
+        s = u.seq.get_zstring(to_app(n)->get_decl()->get_parameter(0).get_symbol());
         return true;
     }
     else {
@@ -23,6 +23,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/bv_decl_plugin.h"
+#include "util/map.h"
 
 
 enum seq_sort_kind {
@@ -85,6 +86,13 @@ enum seq_op_kind {
 };
 
 
+/**
+   \brief Immutable string of characters.
+
+   The characters are stored in a reference counted buffer that is shared
+   between copies and substrings, so copying and extract are constant time.
+   The hash code is computed on demand and cached.
+*/
 class zstring {
 public:
     enum encoding {
@@ -92,8 +100,22 @@ public:
         unicode
     };
 private:
-    buffer<unsigned> m_buffer;
+    struct rep {
+        unsigned m_ref_count;
+        unsigned m_size;
+        unsigned m_data[1];
+    };
+    rep*             m_rep;
+    unsigned         m_offset;
+    unsigned         m_length;
+    mutable unsigned m_hash;
+    mutable bool     m_hash_valid;
     encoding         m_encoding;
+
+    void init(unsigned sz, unsigned const* s);
+    void inc_ref() { if (m_rep) m_rep->m_ref_count++; }
+    void dec_ref();
+    unsigned const* data() const { return m_rep ? m_rep->m_data + m_offset : nullptr; }
 public:
     zstring(encoding enc = ascii);
     zstring(char const* s, encoding enc = ascii);
@@ -101,19 +123,21 @@ public:
     zstring(zstring const& other);
     zstring(unsigned num_bits, bool const* ch);
     zstring(unsigned ch, encoding enc = ascii);
+    ~zstring() { dec_ref(); }
     zstring& operator=(zstring const& other);
     zstring replace(zstring const& src, zstring const& dst) const;
     unsigned num_bits() const { return (m_encoding==ascii)?8:16; }
     encoding get_encoding() const { return m_encoding; }
     std::string encode() const;
-    unsigned length() const { return m_buffer.size(); }
-    unsigned operator[](unsigned i) const { return m_buffer[i]; }
-    bool empty() const { return m_buffer.empty(); }
+    unsigned length() const { return m_length; }
+    unsigned operator[](unsigned i) const { SASSERT(i < m_length); return m_rep->m_data[m_offset + i]; }
+    bool empty() const { return m_length == 0; }
+    unsigned hash() const;
     bool suffixof(zstring const& other) const;
     bool prefixof(zstring const& other) const;
     bool contains(zstring const& other) const;
     int  indexof(zstring const& other, int offset) const;
-    zstring extract(int lo, int hi) const;
+    zstring extract(int offset, int len) const;
     zstring operator+(zstring const& other) const;
     bool operator==(const zstring& other) const;
     bool operator!=(const zstring& other) const;
@@ -122,6 +146,10 @@ public:
     friend bool operator<(const zstring& lhs, const zstring& rhs);
 };
 
+struct zstring_hash_proc {
+    unsigned operator()(zstring const & s) const { return s.hash(); }
+};
+
 class seq_decl_plugin : public decl_plugin {
     struct psig {
         symbol          m_name;
@@ -145,6 +173,13 @@ class seq_decl_plugin : public decl_plugin {
     sort*            m_string;
     sort*            m_char;
     sort*            m_re;
+    // String constants are represented by symbols. The decoding of the symbols, and 
+    // the symbols of the strings passed to mk_string, keyed by their characters, are cached. 
+    // Each cache has two generations, the older one is dropped when the newer one is full.
+    typedef map<symbol, zstring, symbol_hash_proc, symbol_eq_proc> symbol2zstring;
+    typedef map<zstring, symbol, zstring_hash_proc, default_eq<zstring> > zstring2symbol;
+    symbol2zstring   m_sym2zstring[2];
+    zstring2symbol   m_zstring2sym[2];
 
     void match(psig& sig, unsigned dsz, sort* const* dom, sort* range, sort_ref& rng);
 
@@ -196,6 +231,8 @@ public:
     app* mk_string(symbol const& s);
     app* mk_string(zstring const& s);
 
+    zstring get_zstring(symbol const& s);
+
 };
 
 class seq_util {
@@ -29,7 +29,8 @@ grobner::grobner(ast_manager & m, v_dependency_manager & d):
     m_var_lt(m_var2weight),
     m_monomial_lt(m_var_lt),
     m_changed_leading_term(false),
-    m_unsat(nullptr) {
+    m_unsat(nullptr),
+    m_last_processed(nullptr) {
 }
 
 grobner::~grobner() {
@@ -117,6 +118,7 @@ void grobner::reset() {
     m_equations_to_unfreeze.reset();
     m_equations_to_delete.reset();
     m_unsat = nullptr;
+    m_last_processed = nullptr;
 }
 
 void grobner::display_var(std::ostream & out, expr * var) const {
@@ -937,6 +939,7 @@ void grobner::compute_basis_init() {
 }
 
 bool grobner::compute_basis_step() {
+    m_last_processed = nullptr;
     equation * eq = pick_next();
     if (!eq)
         return true;
@@ -957,6 +960,7 @@ bool grobner::compute_basis_step() {
     superpose(eq);
     m_processed.insert(eq);
     simplify_to_process(eq);
+    m_last_processed = eq;
     TRACE("grobner", tout << "end of iteration:\n"; display(tout););
     return false;
 }
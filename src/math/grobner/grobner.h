@@ -104,6 +104,7 @@ protected:
     equation_vector         m_equations_to_delete;
     bool                    m_changed_leading_term; // set to true, if the leading term was simplified.
     equation *              m_unsat; 
+    equation *              m_last_processed; // equation moved to m_processed by the last compute_basis_step
     struct scope {
         unsigned m_equations_to_unfreeze_lim;
         unsigned m_equations_to_delete_lim;
@@ -259,6 +260,12 @@ public:
     bool compute_basis_step();
     unsigned get_num_new_equations() { return m_num_new_equations; }
 
+    /**
+       \brief Return the equation added to the basis by the last call to compute_basis_step,
+       or nullptr if the step did not add one. The equation is valid until the next step.
+    */
+    equation const * get_last_processed() const { return m_last_processed; }
+
 
     /**
        \brief Return true if an inconsistency was detected.
@@ -82,6 +82,11 @@ namespace algebraic_numbers {
         scoped_mpbq_vector       m_isolate_lowers;
         scoped_mpbq_vector       m_isolate_uppers;
         scoped_upoly             m_add_tmp;
+        // direct mapped cache from univariate polynomials to their sorted roots,
+        // the slot of a polynomial is determined by the hash of its coefficients
+        static const unsigned    ISOLATE_CACHE_SIZE = 512;
+        vector<upoly>            m_isolate_cache_polys;
+        vector<numeral_vector>   m_isolate_cache_roots;
         polynomial::var          m_x;
         polynomial::var          m_y;
 
@@ -96,6 +101,7 @@ namespace algebraic_numbers {
         unsigned                 m_compare_sturm;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
+        unsigned                 m_isolate_cache_hits;
 
         imp(reslimit& lim, manager & w, unsynch_mpq_manager & m, params_ref const & p, small_object_allocator & a):
             m_limit(lim),
@@ -123,6 +129,8 @@ namespace algebraic_numbers {
         }
 
         ~imp() {
+            for (unsigned i = 0; i < m_isolate_cache_polys.size(); i++)
+                reset_isolate_cache_slot(i);
         }
 
         void checkpoint() {
@@ -136,6 +144,7 @@ namespace algebraic_numbers {
             m_compare_sturm   = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
+            m_isolate_cache_hits = 0;
         }
 
         void collect_statistics(statistics & st) {
@@ -144,6 +153,7 @@ namespace algebraic_numbers {
             st.update("algebraic compare sturm", m_compare_sturm);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
+            st.update("algebraic isolate cache hits", m_isolate_cache_hits);
 #endif
         }
 
@@ -564,10 +574,55 @@ namespace algebraic_numbers {
             std::sort(r.begin(), r.end(), lt_proc(m_wrapper));
         }
 
+        unsigned isolate_cache_slot(scoped_upoly const & up) const {
+            unsigned h = up.size();
+            for (unsigned i = 0; i < up.size(); i++)
+                h = combine_hash(h, unsynch_mpq_manager::hash(up[i]));
+            return h % ISOLATE_CACHE_SIZE;
+        }
+
+        void reset_isolate_cache_slot(unsigned slot) {
+            upm().reset(m_isolate_cache_polys[slot]);
+            numeral_vector & rs = m_isolate_cache_roots[slot];
+            for (unsigned i = 0; i < rs.size(); i++)
+                del(rs[i]);
+            rs.reset();
+        }
+
         void isolate_roots(scoped_upoly const & up, numeral_vector & roots) {
             TRACE("algebraic", upm().display(tout, up); tout << "\n";);
             if (up.empty())
                 return; // ignore the zero polynomial
+            if (m_isolate_cache_polys.empty()) {
+                m_isolate_cache_polys.resize(ISOLATE_CACHE_SIZE);
+                m_isolate_cache_roots.resize(ISOLATE_CACHE_SIZE);
+            }
+            unsigned slot = isolate_cache_slot(up);
+            unsigned old_sz = roots.size();
+            if (upm().eq(up, m_isolate_cache_polys[slot])) {
+                m_isolate_cache_hits++;
+                numeral_vector const & rs = m_isolate_cache_roots[slot];
+                for (unsigned i = 0; i < rs.size(); i++) {
+                    roots.push_back(numeral());
+                    set(roots.back(), rs[i]);
+                }
+                if (old_sz > 0)
+                    sort_roots(roots);
+                return;
+            }
+            isolate_roots_core(up, roots);
+            if (old_sz == 0) {
+                reset_isolate_cache_slot(slot);
+                upm().set(up.size(), up.c_ptr(), m_isolate_cache_polys[slot]);
+                numeral_vector & rs = m_isolate_cache_roots[slot];
+                for (unsigned i = 0; i < roots.size(); i++) {
+                    rs.push_back(numeral());
+                    set(rs.back(), roots[i]);
+                }
+            }
+        }
+
+        void isolate_roots_core(scoped_upoly const & up, numeral_vector & roots) {
             factors & fs = m_isolate_factors;
             fs.reset();
             bool full_fact;
@@ -26,6 +26,7 @@ Notes:
 #include "util/util.h"
 #include "math/polynomial/upolynomial_factorization_int.h"
 #include "util/prime_generator.h"
+#include "util/cooperate.h"
 
 using namespace std;
 
@@ -1181,6 +1182,18 @@ bool factor_square_free(z_manager & upm, numeral_vector const & f, factors & fs,
     // the leading coefficient of f_pp mod p^e
     scoped_numeral f_pp_lc(nm);
     zpe_nm.set(f_pp_lc, f_pp.back());
+
+    // Bound on the coefficient of x^{d-1} of a factor of degree d of f_pp (Mignotte): |f_pp|_1 + (d-1)*lc(f_pp).
+    // A trial factor lc*g is the image of a true factor only if lc times this bound is not exceeded by its
+    // coefficient of x^{d-1}, which is the sum of the corresponding coefficients of the lifted factors (trace test).
+    scoped_numeral f_norm(nm), f_lc(nm);
+    for (unsigned i = 0; i < f_pp.size(); ++ i) {
+        nm.set(f_lc, f_pp[i]);
+        nm.abs(f_lc);
+        nm.add(f_norm, f_lc, f_norm);
+    }
+    nm.set(f_lc, f_pp.back());
+    nm.abs(f_lc);
     
     // we always keep in f_pp the actual primitive part f_pp*lc(f_pp)
     upm.mul(f_pp, f_pp_lc);
@@ -1197,8 +1210,15 @@ bool factor_square_free(z_manager & upm, numeral_vector const & f, factors & fs,
     bool result = true;
     bool remove = false;
     unsigned counter = 0;
+    unsigned pruned = 0;
+    scoped_numeral trace(nm), trace_bound(nm);
     while (it.next(remove)) {
-        upm.checkpoint();
+        if (!upm.lim().inc()) {
+            // out of resources, return the partial factorization found so far
+            result = false;
+            break;
+        }
+        cooperate("upolynomial");
         counter++;
         if (counter > params.m_max_search_size) {
             // stop search
@@ -1211,6 +1231,29 @@ bool factor_square_free(z_manager & upm, numeral_vector const & f, factors & fs,
         // but, if we take the rest and it works, it doesn't mean that the rest is factorized, so we still take out
         // the original factor
         bool using_left = it.current_degree() <= zp_fs.get_degree()/2;
+        // do the (cheaper) trace test first
+        unsigned trace_degree;
+        if (using_left) {
+            it.get_left_trace(f_pp_lc, trace);
+            trace_degree = it.current_degree();
+        }
+        else {
+            it.get_right_trace(f_pp_lc, trace);
+            trace_degree = upm.degree(f_pp) - it.current_degree();
+        }
+        SASSERT(trace_degree > 0);
+        nm.set(trace_bound, trace_degree - 1);
+        nm.mul(trace_bound, f_lc, trace_bound);
+        nm.add(trace_bound, f_norm, trace_bound);
+        nm.mul(trace_bound, f_pp_lc, trace_bound);
+        nm.abs(trace);
+        nm.abs(trace_bound);
+        if (nm.gt(trace, trace_bound)) {
+            // don't remove this combination
+            pruned++;
+            remove = false;
+            continue;
+        }
         if (using_left) {
             // do a quick check first
             scoped_numeral tmp(nm);
@@ -1278,7 +1321,7 @@ bool factor_square_free(z_manager & upm, numeral_vector const & f, factors & fs,
         );
     }
 #ifndef _EXTERNAL_RELEASE 
-    IF_VERBOSE(FACTOR_VERBOSE_LVL, verbose_stream() << "(polynomial-factorization :search-size " << counter << ")" << std::endl;);
+    IF_VERBOSE(FACTOR_VERBOSE_LVL, verbose_stream() << "(polynomial-factorization :search-size " << counter << " :trace-pruned " << pruned << ")" << std::endl;);
 #endif
 
     // add the what's left to the factors (if not a constant)
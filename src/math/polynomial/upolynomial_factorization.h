@@ -84,6 +84,8 @@ namespace upolynomial {
     /**
        \brief Factor the square-free polynomial f from Z[x]. Returns true if factorization was successful, or false if
        f is an irreducible polynomial in Z[x]. The vector of factors is cleared.
+       If the search for factor combinations exceeds ps.m_max_search_size, or the resource limit of upm is reached
+       during the search, the method also returns false and fs contains the partial factorization found so far.
     */
     bool factor_square_free(z_manager & upm, numeral_vector const & f, factors & fs, factor_params const & ps = factor_params());
     /**
@@ -385,6 +385,47 @@ namespace upolynomial {
             }
         }
 
+        /**
+           \brief Returns m times the sum of the coefficients of x^{d-1} of the (monic) factors in the current
+           selection. This is the coefficient of x^{d-1} in m*left(), where d is the degree of left().
+        */
+        void get_left_trace(numeral const & m, numeral & out) {
+            zp_numeral_manager &  nm = m_factors.upm().m();
+            nm.reset(out);
+            for (int i = 0; i < m_current_size; ++ i) {
+                numeral_vector const & f = m_factors[m_current[i]];
+                nm.add(out, f[f.size() - 2], out);
+            }
+            nm.mul(out, m, out);
+        }
+
+        /**
+           \brief Same as get_left_trace, but for the factors in right().
+        */
+        void get_right_trace(numeral const & m, numeral & out) {
+            zp_numeral_manager &  nm = m_factors.upm().m();
+            nm.reset(out);
+
+            unsigned current = 0;
+            unsigned selection_i = 0;
+
+            while (current <  m_factors.distinct_factors()) {
+                if (!m_enabled[current]) {
+                    current ++;
+                } else {
+                    if (selection_i >= m_current.size() || (int) current < m_current[selection_i]) {
+                        numeral_vector const & f = m_factors[current];
+                        nm.add(out, f[f.size() - 2], out);
+                        current ++;
+                    } else {
+                        current ++;
+                        selection_i ++;
+                    }
+                }
+            }
+            nm.mul(out, m, out);
+        }
+
         void right(numeral_vector & out) const {
             SASSERT(m_current_size > 0);
             zp_manager & upm = m_factors.upm();
@@ -527,6 +527,7 @@ private:
     // Temporary
     numeral                   m_tmp1, m_tmp2, m_tmp3;
     interval                  m_i_tmp1, m_i_tmp2, m_i_tmp3;
+    svector<interval>         m_i_buffer;
 
 
     friend class node;
@@ -688,6 +689,11 @@ private:
     void propagate_polynomial(var x, node * n);
     // Propagate a new bound for y using the polynomial associated with x. x may be equal to y.
     void propagate_polynomial(var x, node * n, var y);
+    // Propagate new bounds for x and all variables of the polynomial associated with x using O(size) interval operations.
+    // \pre all variables in the polynomial and x are bounded.
+    void propagate_polynomial_all(var x, node * n);
+    // Propagate the bounds in r (the deduced bounds for y) using the polynomial associated with x.
+    void propagate_polynomial_bounds(var x, node * n, var y, interval & r);
 
     /**
        \brief Propagate new bounds at node n using clause c.
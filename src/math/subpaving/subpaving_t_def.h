@@ -449,6 +449,8 @@ context_t<C>::~context_t() {
     del(m_i_tmp1);
     del(m_i_tmp2);
     del(m_i_tmp3);
+    for (interval & i : m_i_buffer)
+        del(i);
     del_nodes();
     del_unit_clauses();
     del_clauses();
@@ -1446,6 +1448,11 @@ void context_t<C>::propagate_polynomial(var x, node * n, var y) {
         TRACE("propagate_polynomial_bug", tout << "r after mul 1/a:  "; im().display(tout, r); tout << "\n";);
         // r contains the deduced bounds for y.
     }
+    propagate_polynomial_bounds(x, n, y, r);
+}
+
+template<typename C>
+void context_t<C>::propagate_polynomial_bounds(var x, node * n, var y, interval & r) {
     // r contains the deduced bounds for y.
     if (!r.m_l_inf) {
         normalize_bound(y, r.m_l_val, true, r.m_l_open);
@@ -1487,12 +1494,74 @@ void context_t<C>::propagate_polynomial(var x, node * n) {
         propagate_polynomial(x, n, unbounded_var);
     }
     else {
-        propagate_polynomial(x, n, x);
-        for (unsigned i = 0; i < sz; i++) {
-            if (inconsistent(n))
-                return;
-            propagate_polynomial(x, n, p->x(i));
+        propagate_polynomial_all(x, n);
+    }
+}
+
+/**
+   \brief Let p be a_0*z_0 + ... + a_{sz-1}*z_{sz-1}, and t_i the interval a_i*z_i.
+   Instead of computing the sum of sz-1 terms for each z_j, we compute the suffix sums
+   s_j = t_{j+1} + ... + t_{sz-1} once, and then z_j = (x - (t_0 + ... + t_{j-1}) - s_j)/a_j
+   while accumulating the prefix sum. The term intervals are computed once, so the bounds
+   deduced for z_j do not take into account the bounds deduced for z_0, ..., z_{j-1} in this call.
+   They are propagated again when the new bounds are processed.
+*/
+template<typename C>
+void context_t<C>::propagate_polynomial_all(var x, node * n) {
+    SASSERT(is_polynomial(x));
+    polynomial * p = get_polynomial(x);
+    unsigned sz    = p->size();
+    SASSERT(sz > 0);
+    unsigned old_sz = m_i_buffer.size();
+    if (old_sz < 2*sz + 2) {
+        m_i_buffer.resize(2*sz + 2);
+        for (unsigned i = old_sz; i < m_i_buffer.size(); i++)
+            m_i_buffer[i].set_mutable();
+    }
+    interval * ts      = m_i_buffer.c_ptr();
+    interval * ss      = ts + sz;
+    interval & prefix  = m_i_buffer[2*sz];
+    interval & others  = m_i_buffer[2*sz + 1];
+    interval & r       = m_i_tmp1; r.set_mutable();
+    interval & v       = m_i_tmp2;
+    for (unsigned i = 0; i < sz; i++) {
+        v.set_constant(n, p->x(i));
+        im().mul(p->a(i), v, ts[i]);
+    }
+    if (sz > 1) {
+        im().set(ss[sz - 2], ts[sz - 1]);
+        for (unsigned i = sz - 2; i-- > 0; )
+            im().add(ts[i + 1], ss[i + 1], ss[i]);
+        im().add(ts[0], ss[0], r);
+    }
+    else {
+        im().set(r, ts[0]);
+    }
+    // r contains the deduced bounds for x
+    propagate_polynomial_bounds(x, n, x, r);
+    for (unsigned j = 0; j < sz; j++) {
+        if (inconsistent(n))
+            return;
+        // others := t_0 + ... + t_{j-1} + t_{j+1} + ... + t_{sz-1}
+        v.set_constant(n, x);
+        if (sz == 1) {
+            im().set(r, v);
         }
+        else {
+            if (j == 0)
+                im().set(others, ss[0]);
+            else if (j == sz - 1)
+                im().set(others, prefix);
+            else
+                im().add(prefix, ss[j], others);
+            im().sub(v, others, r);
+        }
+        im().div(r, p->a(j), r);
+        propagate_polynomial_bounds(x, n, p->x(j), r);
+        if (j == 0)
+            im().set(prefix, ts[0]);
+        else
+            im().add(prefix, ts[j], prefix);
     }
 }
 
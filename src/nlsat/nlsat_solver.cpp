@@ -1383,6 +1383,17 @@ namespace nlsat {
             m_asm.linearize(m_lemma_assumptions.get(), deps);
         }
 
+        void get_lemmas(unsigned max_size, vector<literal_vector> & lemmas) const {
+            for (clause * c : m_learned) {
+                if (c->size() > max_size || c->assumptions() != nullptr)
+                    continue;
+                literal_vector lits;
+                for (unsigned i = 0; i < c->size(); i++)
+                    lits.push_back((*c)[i]);
+                lemmas.push_back(lits);
+            }
+        }
+
         void collect(literal_vector const& assumptions, clause_vector& clauses) {
             unsigned n = clauses.size();
             unsigned j  = 0;
@@ -3073,6 +3084,14 @@ namespace nlsat {
         return m_imp->get_core(assumptions);
     }
 
+    unsigned solver::num_conflicts() const {
+        return m_imp->m_conflicts;
+    }
+
+    void solver::get_lemmas(unsigned max_size, vector<literal_vector> & lemmas) const {
+        m_imp->get_lemmas(max_size, lemmas);
+    }
+
     void solver::reset() {
         m_imp->reset();
     }
@@ -184,6 +184,17 @@ namespace nlsat {
 
         lbool check(literal_vector& assumptions);
 
+        /**
+           \brief Return the number of conflicts since the last reset_statistics.
+        */
+        unsigned num_conflicts() const;
+
+        /**
+           \brief Store in lemmas the learned clauses of size at most max_size that do not depend on
+           clauses created with assumptions. That is, they are consequences of the clauses without assumptions.
+        */
+        void get_lemmas(unsigned max_size, vector<literal_vector> & lemmas) const;
+
         // -----------------------
         //
         // Model
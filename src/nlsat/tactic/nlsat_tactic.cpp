@@ -15,14 +15,27 @@ Author:
 
 Notes:
 
+    When nlsat.threads > 1, the real line of the variable with the most
+    univariate constraints is split at (rational approximations of) the
+    roots of these constraints. Each cell is solved by an nlsat solver over
+    a copy of the goal in its own ast_manager. The solvers run in rounds
+    bounded by a number of conflicts. Between rounds, short learned clauses
+    that do not depend on the cell constraints are exchanged.
+
 --*/
+#include<algorithm>
+#include "util/z3_omp.h"
+#include "util/scoped_ptr_vector.h"
 #include "tactic/tactical.h"
 #include "nlsat/tactic/goal2nlsat.h"
 #include "nlsat/nlsat_solver.h"
+#include "nlsat/nlsat_params.hpp"
 #include "model/model.h"
 #include "ast/expr2var.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_translation.h"
+#include "ast/ast_util.h"
 #include "util/z3_exception.h"
 #include "math/polynomial/algebraic_numbers.h"
 #include "ast/ast_pp.h"
@@ -128,6 +141,329 @@ class nlsat_tactic : public tactic {
             return ok;
         }
 
+        /**
+           \brief Split the real line of the variable with the most univariate atoms at the roots of their
+           polynomials. If there are no univariate atoms, the real line of the variable occurring in the most
+           atoms is split at 0. Store in cells constraints covering the real line.
+           Return false if there are no arithmetic atoms.
+        */
+        bool mk_cells(expr2var const & t2x, unsigned max_cells, expr_ref_vector & cells) {
+            nlsat::atom_vector const & atoms = m_solver.get_atoms();
+            unsigned_vector counts, all_counts;
+            for (nlsat::atom * a : atoms) {
+                if (a == nullptr || a->max_var() == nlsat::null_var)
+                    continue;
+                all_counts.reserve(a->max_var() + 1, 0);
+                all_counts[a->max_var()]++;
+                if (is_univariate(a)) {
+                    counts.reserve(a->max_var() + 1, 0);
+                    counts[a->max_var()]++;
+                }
+            }
+            if (counts.empty())
+                counts.swap(all_counts);
+            nlsat::var x = nlsat::null_var;
+            for (nlsat::var y = 0; y < counts.size(); y++) {
+                if (counts[y] > 0 && (x == nlsat::null_var || counts[y] > counts[x]))
+                    x = y;
+            }
+            if (x == nlsat::null_var)
+                return false;
+
+            anum_manager & am = m_solver.am();
+            scoped_anum_vector roots(am);
+            polynomial_ref p(m_solver.pm());
+            vector<rational> cuts;
+            for (nlsat::atom * a : atoms) {
+                if (!is_univariate(a) || a->max_var() != x)
+                    continue;
+                nlsat::ineq_atom * ia = nlsat::to_ineq_atom(a);
+                for (unsigned i = 0; i < ia->size(); i++) {
+                    p = ia->p(i);
+                    roots.reset();
+                    am.isolate_roots(p, roots);
+                    for (unsigned j = 0; j < roots.size(); j++) {
+                        rational c;
+                        if (am.is_rational(roots[j]))
+                            am.to_rational(roots[j], c);
+                        else
+                            am.get_lower(roots[j], c);
+                        cuts.push_back(c);
+                    }
+                }
+            }
+
+            expr_ref_vector x2t(m);
+            t2x.mk_inv(x2t);
+            expr * t = x2t.get(x);
+            arith_util a(m);
+            bool is_int = a.is_int(t);
+            if (is_int) {
+                for (rational & c : cuts)
+                    c = floor(c);
+            }
+            std::sort(cuts.begin(), cuts.end());
+            cuts.shrink(static_cast<unsigned>(std::unique(cuts.begin(), cuts.end()) - cuts.begin()));
+            if (cuts.empty())
+                cuts.push_back(rational(0));
+            if (cuts.size() >= max_cells) {
+                vector<rational> sel;
+                for (unsigned i = 1; i < max_cells; i++)
+                    sel.push_back(cuts[i * cuts.size() / max_cells]);
+                cuts.swap(sel);
+            }
+
+            // x <= c_0, c_0 < x <= c_1, ..., c_{k-1} < x
+            // goal2nlsat only accepts <=, >= and = atoms.
+            cells.push_back(a.mk_le(t, a.mk_numeral(cuts[0], is_int)));
+            for (unsigned i = 1; i < cuts.size(); i++) {
+                cells.push_back(m.mk_and(m.mk_not(a.mk_le(t, a.mk_numeral(cuts[i - 1], is_int))),
+                                         a.mk_le(t, a.mk_numeral(cuts[i], is_int))));
+            }
+            cells.push_back(m.mk_not(a.mk_le(t, a.mk_numeral(cuts.back(), is_int))));
+            return true;
+        }
+
+        static bool is_univariate(nlsat::atom const * a) {
+            if (a == nullptr || !a->is_ineq_atom() || a->max_var() == nlsat::null_var)
+                return false;
+            nlsat::ineq_atom const * ia = nlsat::to_ineq_atom(a);
+            for (unsigned i = 0; i < ia->size(); i++) {
+                if (!polynomial::manager::is_univariate(ia->p(i)) || polynomial::manager::max_var(ia->p(i)) != a->max_var())
+                    return false;
+            }
+            return true;
+        }
+
+        /**
+           \brief Convert the short lemmas of s into formulas. Lemmas containing root atoms are skipped.
+        */
+        void get_lemmas(expr2var const & a2b, expr2var const & t2x, unsigned max_size, expr_ref_vector & lemmas) {
+            vector<nlsat::literal_vector> ls;
+            m_solver.get_lemmas(max_size, ls);
+            if (ls.empty())
+                return;
+            expr_ref_vector b2a_vec(m), x2t_vec(m);
+            a2b.mk_inv(b2a_vec);
+            t2x.mk_inv(x2t_vec);
+            u_map<expr*> b2a, x2t;
+            for (unsigned b = 0; b < b2a_vec.size(); b++)
+                if (b2a_vec.get(b))
+                    b2a.insert(b, b2a_vec.get(b));
+            for (unsigned x = 0; x < x2t_vec.size(); x++)
+                if (x2t_vec.get(x))
+                    x2t.insert(x, x2t_vec.get(x));
+            nlsat2goal n2g(m);
+            arith_util a(m);
+            expr * lhs, * rhs;
+            for (nlsat::literal_vector const & lemma : ls) {
+                expr_ref_vector lits(m);
+                for (nlsat::literal l : lemma) {
+                    nlsat::atom * at = m_solver.bool_var2atom(l.var());
+                    if (at ? !at->is_ineq_atom() : !b2a.contains(l.var()))
+                        break;
+                    expr_ref lit = n2g(m_solver, b2a, x2t, l);
+                    // goal2nlsat only accepts <=, >= and = atoms.
+                    if (a.is_lt(lit, lhs, rhs))
+                        lit = m.mk_not(a.mk_ge(lhs, rhs));
+                    else if (a.is_gt(lit, lhs, rhs))
+                        lit = m.mk_not(a.mk_le(lhs, rhs));
+                    lits.push_back(lit);
+                }
+                if (lits.size() == lemma.size())
+                    lemmas.push_back(mk_or(lits));
+            }
+        }
+
+        enum par_exception_kind {
+            NO_EX,
+            DEFAULT_EX,
+            ERROR_EX
+        };
+
+        /**
+           \brief Solve g by solving the cells in parallel.
+           If the result is l_true and the model of the cell is usable, store the model converter in mc.
+        */
+        lbool check_parallel(goal_ref const & g, expr_ref_vector const & cells, unsigned num_threads, model_converter_ref & mc) {
+            nlsat_params np(m_params);
+            unsigned num_cells = cells.size();
+            scoped_ptr_vector<ast_manager> pms;
+            scoped_ptr_vector<imp>         pimps;
+            scoped_ptr_vector<expr2var>    pa2bs;
+            scoped_ptr_vector<expr2var>    pt2xs;
+            goal_ref_vector                pgoals;
+            scoped_limits                  sl(m.limit());
+            // lemmas exchanged between the cells, in the manager of g.
+            expr_ref_vector                shared(m);
+            obj_hashtable<expr>            shared_set;
+            unsigned_vector                shared_lim;
+            svector<lbool>                 results;
+
+            for (unsigned i = 0; i < num_cells; ++i) {
+                ast_manager * pm = alloc(ast_manager, m, true);
+                pms.push_back(pm);
+                sl.push_child(&(pm->limit()));
+                imp * pimp = alloc(imp, *pm, m_params);
+                pimps.push_back(pimp);
+                expr2var * a2b = alloc(expr2var, *pm);
+                expr2var * t2x = alloc(expr2var, *pm);
+                pa2bs.push_back(a2b);
+                pt2xs.push_back(t2x);
+                ast_translation tr(m, *pm, false);
+                goal_ref pg = g->translate(tr);
+                pimp->m_g2nl(*pg, m_params, pimp->m_solver, *a2b, *t2x);
+                pgoals.push_back(pg.get());
+                // the cell constraints are tracked, so lemmas that depend on them are not shared.
+                goal_ref cg = alloc(goal, *pm, false, false, true);
+                expr_ref cell(tr(cells.get(i)), *pm);
+                expr_ref_vector conjs(*pm);
+                flatten_and(cell, conjs);
+                for (expr * c : conjs)
+                    cg->assert_expr(c, nullptr, pm->mk_leaf(c));
+                pimp->m_g2nl(*cg, m_params, pimp->m_solver, *a2b, *t2x);
+                pgoals.push_back(cg.get());
+                shared_lim.push_back(0);
+                results.push_back(l_undef);
+            }
+
+            unsigned max_conflicts = np.threads_max_conflicts();
+            unsigned num_conflicts = 0;
+            unsigned round         = 0;
+            while (true) {
+                unsigned budget = std::min(max_conflicts, np.max_conflicts() - num_conflicts);
+                unsigned sat_id            = UINT_MAX;
+                unsigned undef_id          = UINT_MAX;
+                par_exception_kind ex_kind = NO_EX;
+                std::string        ex_msg;
+                unsigned           error_code = 0;
+                // params_ref is not reference counted atomically, so the cells are configured before the parallel region.
+                unsigned_vector    limits;
+                for (unsigned i = 0; i < num_cells; ++i) {
+                    limits.push_back(pimps[i]->m_solver.num_conflicts() + budget);
+                    if (results[i] != l_undef)
+                        continue;
+                    params_ref p(m_params);
+                    p.set_uint("max_conflicts", limits.back());
+                    pimps[i]->m_solver.updt_params(p);
+                }
+
+                #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+                for (int i = 0; i < static_cast<int>(num_cells); ++i) {
+                    if (results[i] != l_undef)
+                        continue;
+                    imp & pimp = *pimps[i];
+                    try {
+                        lbool r = pimp.m_solver.check();
+                        if (r == l_undef && pimp.m_solver.num_conflicts() >= limits[i])
+                            continue;
+                        bool first = false;
+                        #pragma omp critical (nlsat_parallel)
+                        {
+                            results[i] = r;
+                            if (r == l_undef)
+                                undef_id = i;
+                            else if (r == l_true && sat_id == UINT_MAX) {
+                                sat_id = i;
+                                first = true;
+                            }
+                        }
+                        if (first) {
+                            for (unsigned j = 0; j < num_cells; ++j) {
+                                if (static_cast<unsigned>(i) != j)
+                                    pms[j]->limit().cancel();
+                            }
+                        }
+                    }
+                    catch (z3_error & err) {
+                        #pragma omp critical (nlsat_parallel)
+                        {
+                            ex_kind = ERROR_EX;
+                            error_code = err.error_code();
+                        }
+                    }
+                    catch (z3_exception & ex) {
+                        #pragma omp critical (nlsat_parallel)
+                        {
+                            ex_kind = DEFAULT_EX;
+                            ex_msg = ex.msg();
+                        }
+                    }
+                }
+
+                unsigned num_open = 0;
+                for (lbool r : results)
+                    if (r == l_undef)
+                        num_open++;
+                IF_VERBOSE(1, verbose_stream() << "(nlsat.parallel :round " << round << " :cells " << num_cells << " :open " << num_open
+                           << " :shared " << shared.size() << " :max-conflicts " << max_conflicts << ")\n";);
+
+                if (sat_id != UINT_MAX) {
+                    imp & pimp = *pimps[sat_id];
+                    ast_manager & pm = *pms[sat_id];
+                    expr_ref_vector x2t(pm);
+                    expr_ref_vector b2a(pm);
+                    pa2bs[sat_id]->mk_inv(b2a);
+                    pt2xs[sat_id]->mk_inv(x2t);
+                    model_converter_ref pmc;
+                    if (!pimp.contains_unsupported(b2a, x2t) && pimp.mk_model(*pgoals.get(2 * sat_id), b2a, x2t, pmc)) {
+                        ast_translation tr(pm, m, false);
+                        mc = pmc->translate(tr);
+                    }
+                    return l_true;
+                }
+
+                switch (ex_kind) {
+                case ERROR_EX: throw z3_error(error_code);
+                case DEFAULT_EX: throw default_exception(ex_msg.c_str());
+                default: break;
+                }
+
+                if (undef_id != UINT_MAX)
+                    return l_undef;
+                if (num_open == 0)
+                    return l_false;
+
+                num_conflicts += budget;
+                if (num_conflicts >= np.max_conflicts())
+                    return l_undef;
+
+                // collect short lemmas that do not depend on the cells
+                for (unsigned i = 0; i < num_cells; ++i) {
+                    if (results[i] != l_undef)
+                        continue;
+                    ast_manager & pm = *pms[i];
+                    ast_translation tr(pm, m, false);
+                    expr_ref_vector lemmas(pm);
+                    pimps[i]->get_lemmas(*pa2bs[i], *pt2xs[i], np.threads_max_lemma_size(), lemmas);
+                    for (expr * e : lemmas) {
+                        expr_ref ce(tr(e), m);
+                        if (!shared_set.contains(ce)) {
+                            shared_set.insert(ce);
+                            shared.push_back(ce);
+                        }
+                    }
+                }
+
+                // distribute them
+                for (unsigned i = 0; i < num_cells; ++i) {
+                    if (results[i] != l_undef || shared_lim[i] == shared.size())
+                        continue;
+                    ast_manager & pm = *pms[i];
+                    ast_translation tr(m, pm, false);
+                    goal_ref lg = alloc(goal, pm, false, false, false);
+                    for (unsigned j = shared_lim[i]; j < shared.size(); ++j)
+                        lg->assert_expr(tr(shared.get(j)));
+                    pimps[i]->m_g2nl(*lg, m_params, pimps[i]->m_solver, *pa2bs[i], *pt2xs[i]);
+                    shared_lim[i] = shared.size();
+                }
+
+                ++round;
+                if (max_conflicts < UINT_MAX / 2)
+                    max_conflicts *= 2;
+            }
+        }
+
         void operator()(goal_ref const & g, 
                         goal_ref_buffer & result, 
                         model_converter_ref & mc, 
@@ -153,6 +489,25 @@ class nlsat_tactic : public tactic {
             m_display_var.m_var2expr.reset();
             t2x.mk_inv(m_display_var.m_var2expr);
             m_solver.set_display_var(m_display_var);
+
+            nlsat_params np(m_params);
+            unsigned num_threads = np.threads();
+            expr_ref_vector cells(m);
+            if (num_threads > 1 && !g->unsat_core_enabled() && mk_cells(t2x, 2 * num_threads, cells)) {
+                lbool st = check_parallel(g, cells, num_threads, mc);
+                if (st == l_true) {
+                    if (mc) {
+                        // result goal is trivially SAT
+                        g->reset();
+                    }
+                }
+                else if (st == l_false) {
+                    g->assert_expr(m.mk_false());
+                }
+                g->inc_depth();
+                result.push_back(g.get());
+                return;
+            }
             
             lbool st = m_solver.check();
            
@@ -357,6 +357,8 @@ public:
         }
         if (!m_bb_rewriter) {
             m_bb_rewriter = alloc(bit_blaster_rewriter, m, m_params);
+            // terms shared by the assertions of different scopes are bit-blasted once.
+            m_bb_rewriter->set_term_cache(true);
         }
         params_ref simp2_p = m_params;
         simp2_p.set_bool("som", true);
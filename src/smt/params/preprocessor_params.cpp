@@ -26,6 +26,7 @@ void preprocessor_params::updt_local_params(params_ref const & _p) {
     m_restricted_quasi_macros = p.restricted_quasi_macros();
     m_pull_nested_quantifiers = p.pull_nested_quantifiers();
     m_refine_inj_axiom        = p.refine_inj_axioms();
+    m_bb_mul_tree_threshold   = p.bv_mul_tree_threshold();
 }
 
 void preprocessor_params::updt_params(params_ref const & p) {
@@ -39,7 +39,14 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_timeout = p.timeout();
     m_rlimit  = p.rlimit();
     m_max_conflicts = p.max_conflicts();
+    m_threads = p.threads();
+    m_threads_max_conflicts = p.threads_max_conflicts();
+    m_threads_max_lemma_size = p.threads_max_lemma_size();
     m_core_validate = p.core_validate();
+    m_core_cache_size = p.core_cache_size();
+    m_profile = p.profile();
+    m_profile_trace_file = p.profile_trace_file();
+    m_profile_max_events = p.profile_max_events();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
     model_params mp(_p);
@@ -100,6 +107,9 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_phase_caching_off);
     DISPLAY_PARAM(m_minimize_lemmas);
     DISPLAY_PARAM(m_max_conflicts);
+    DISPLAY_PARAM(m_threads);
+    DISPLAY_PARAM(m_threads_max_conflicts);
+    DISPLAY_PARAM(m_threads_max_lemma_size);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
@@ -133,11 +143,16 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_new_clause_relevancy);
     DISPLAY_PARAM(m_old_clause_relevancy);
     DISPLAY_PARAM(m_inv_clause_decay);
+    DISPLAY_PARAM(m_lemma_gc_core_glue);
+    DISPLAY_PARAM(m_lemma_gc_tier2_glue);
 
     DISPLAY_PARAM(m_smtlib_dump_lemmas);
     DISPLAY_PARAM(m_logic);
 
     DISPLAY_PARAM(m_profile_res_sub);
+    DISPLAY_PARAM(m_profile);
+    DISPLAY_PARAM(m_profile_trace_file);
+    DISPLAY_PARAM(m_profile_max_events);
     DISPLAY_PARAM(m_display_bool_var2expr);
     DISPLAY_PARAM(m_display_ll_bool_var2expr);
     DISPLAY_PARAM(m_abort_after_preproc);
@@ -151,6 +166,7 @@ void smt_params::display(std::ostream & out) const {
 
     DISPLAY_PARAM(m_display_installed_theories);
     DISPLAY_PARAM(m_core_validate);
+    DISPLAY_PARAM(m_core_cache_size);
 
     DISPLAY_PARAM(m_preprocess);
     DISPLAY_PARAM(m_user_theory_preprocess_axioms);
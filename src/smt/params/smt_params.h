@@ -99,6 +99,9 @@ struct smt_params : public preprocessor_params,
     unsigned         m_phase_caching_off;
     bool             m_minimize_lemmas;
     unsigned         m_max_conflicts;
+    unsigned         m_threads;
+    unsigned         m_threads_max_conflicts;
+    unsigned         m_threads_max_lemma_size;
     bool             m_simplify_clauses;
     unsigned         m_tick;
     bool             m_display_features;
@@ -159,6 +162,8 @@ struct smt_params : public preprocessor_params,
     unsigned          m_new_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     unsigned          m_old_clause_relevancy; //!< Max. number of unassigned literals to be considered relevant.
     double            m_inv_clause_decay;     //!< clause activity decay
+    unsigned          m_lemma_gc_core_glue;   //!< lemmas with glue up to this value are never garbage collected.
+    unsigned          m_lemma_gc_tier2_glue;  //!< lemmas with glue up to this value are only collected when inactive and irrelevant.
 
     // -----------------------------------
     //
@@ -174,6 +179,9 @@ struct smt_params : public preprocessor_params,
     //
     // -----------------------------------
     bool              m_profile_res_sub;
+    bool              m_profile;
+    symbol            m_profile_trace_file;
+    unsigned          m_profile_max_events;
     bool              m_display_bool_var2expr;
     bool              m_display_ll_bool_var2expr;
     bool              m_abort_after_preproc;
@@ -202,6 +210,7 @@ struct smt_params : public preprocessor_params,
     // -----------------------------------
     bool             m_display_installed_theories;
     bool             m_core_validate;
+    unsigned         m_core_cache_size;
 
     // -----------------------------------
     //
@@ -253,6 +262,9 @@ struct smt_params : public preprocessor_params,
         m_phase_caching_off(100),
         m_minimize_lemmas(true),
         m_max_conflicts(UINT_MAX),
+        m_threads(1),
+        m_threads_max_conflicts(400),
+        m_threads_max_lemma_size(3),
         m_simplify_clauses(true),
         m_tick(1000),
         m_display_features(false),
@@ -283,9 +295,14 @@ struct smt_params : public preprocessor_params,
         m_new_clause_relevancy(45),
         m_old_clause_relevancy(6),
         m_inv_clause_decay(1),
+        m_lemma_gc_core_glue(2),
+        m_lemma_gc_tier2_glue(6),
         m_smtlib_dump_lemmas(false),
         m_logic(symbol::null),
         m_profile_res_sub(false),
+        m_profile(false),
+        m_profile_trace_file(symbol::null),
+        m_profile_max_events(100000),
         m_display_bool_var2expr(false),
         m_display_ll_bool_var2expr(false),
         m_abort_after_preproc(false),
@@ -296,6 +313,7 @@ struct smt_params : public preprocessor_params,
         m_progress_sampling_freq(0),
         m_display_installed_theories(false),
         m_core_validate(false),
+        m_core_cache_size(0),
         m_preprocess(true), // temporary hack for disabling all preprocessing..
         m_user_theory_preprocess_axioms(false),
         m_user_theory_persist_axioms(false),
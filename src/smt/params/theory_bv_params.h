@@ -34,6 +34,8 @@ struct theory_bv_params {
     bool         m_bv_cc;
     unsigned     m_bv_blast_max_size;
     bool         m_bv_enable_int2bv2int;
+    bool         m_bv_lazy_blast;  //!< bit-blast multipliers and dividers only when their value is inconsistent in final check.
+    unsigned     m_bv_lazy_blast_max_refinements;
     theory_bv_params(params_ref const & p = params_ref()):
         m_bv_mode(BS_BLASTER),
         m_hi_div0(false),
@@ -41,7 +43,9 @@ struct theory_bv_params {
         m_bv_lazy_le(false),
         m_bv_cc(false),
         m_bv_blast_max_size(INT_MAX),
-        m_bv_enable_int2bv2int(true) {
+        m_bv_enable_int2bv2int(true),
+        m_bv_lazy_blast(false),
+        m_bv_lazy_blast_max_refinements(8) {
         updt_params(p);
     }
     
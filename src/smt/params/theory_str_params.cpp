@@ -37,4 +37,6 @@ void theory_str_params::updt_params(params_ref const & _p) {
     m_RegexAutomata_FailedAutomatonThreshold = p.str_regex_automata_failed_automaton_threshold();
     m_RegexAutomata_FailedIntersectionThreshold = p.str_regex_automata_failed_intersection_threshold();
     m_RegexAutomata_LengthAttemptThreshold = p.str_regex_automata_length_attempt_threshold();
+    m_LengthPresolve = p.str_length_presolve();
+    m_LengthPresolveMaxConflicts = p.str_length_presolve_max_conflicts();
 }
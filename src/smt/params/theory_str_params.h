@@ -117,6 +117,20 @@ struct theory_str_params {
      */
     unsigned m_RegexAutomata_LengthAttemptThreshold;
 
+    /*
+     * If LengthPresolve is set to true, the asserted formulas are abstracted to
+     * constraints over the lengths of string terms, which are checked by an arithmetic solver
+     * before the search. Unsatisfiability of the abstraction is reported immediately,
+     * and the lengths in a model of the abstraction seed the search for free variable lengths.
+     * The abstraction is checked again only when formulas were asserted since the last check.
+     */
+    bool m_LengthPresolve;
+
+    /*
+     * LengthPresolveMaxConflicts is the conflict budget of the length abstraction check.
+     */
+    unsigned m_LengthPresolveMaxConflicts;
+
     theory_str_params(params_ref const & p = params_ref()):
         m_StrongArrangements(true),
         m_AggressiveLengthTesting(false),
@@ -134,7 +148,9 @@ struct theory_str_params {
         m_RegexAutomata_IntersectionDifficultyThreshold(1000),
         m_RegexAutomata_FailedAutomatonThreshold(10),
         m_RegexAutomata_FailedIntersectionThreshold(10),
-        m_RegexAutomata_LengthAttemptThreshold(10)
+        m_RegexAutomata_LengthAttemptThreshold(10),
+        m_LengthPresolve(false),
+        m_LengthPresolveMaxConflicts(1000)
     {
         updt_params(p);
     }
@@ -433,8 +433,11 @@ namespace smt {
 
         TRACE("conflict_verbose",m_ctx.display_literals_verbose(tout << "before minimization:\n", m_lemma) << "\n";);
 
-        if (m_params.m_minimize_lemmas)
+        if (m_params.m_minimize_lemmas) {
             minimize_lemma();
+            if (!m_manager.proofs_enabled())
+                minimize_lemma_binary();
+        }
 
         TRACE("conflict", m_ctx.display_literals(tout << "after minimization:\n", m_lemma) << "\n";);
         TRACE("conflict_verbose", m_ctx.display_literals_verbose(tout << "after minimization:\n", m_lemma) << "\n";);
@@ -505,8 +508,10 @@ namespace smt {
             case b_justification::CLAUSE: {
                 clause * cls = js.get_clause();
                 TRACE("conflict", m_ctx.display_clause_detail(tout, cls););
-                if (cls->is_lemma())
+                if (cls->is_lemma()) {
                     cls->inc_clause_activity();
+                    update_glue(cls);
+                }
                 unsigned num_lits = cls->get_num_literals();
                 unsigned i        = 0;
                 if (consequent != false_literal) {
@@ -746,6 +751,59 @@ namespace smt {
         m_ctx.m_stats.m_num_minimized_lits += sz - j;
     }
 
+    /**
+       \brief Remove the literals ~l from the lemma such that (m_lemma[0] or l) is a binary clause.
+       The lemma is strengthened by resolving it with the binary clause.
+       
+       \pre The literals m_lemma[1] ... m_lemma[m_lemma.size() - 1] are marked.
+    */
+    void conflict_resolution::minimize_lemma_binary() {
+        watch_list & w = m_watches[(~m_lemma[0]).index()];
+        literal * it   = w.begin_literals();
+        literal * end  = w.end_literals();
+        if (it == end)
+            return;
+        unsigned num_removed = 0;
+        for (; it != end; ++it) {
+            literal l = *it;
+            // ~l is in the lemma iff l is true and its variable is marked
+            if (m_ctx.is_marked(l.var()) && m_ctx.get_assignment(l) == l_true) {
+                m_ctx.unset_mark(l.var());
+                num_removed++;
+            }
+        }
+        if (num_removed == 0)
+            return;
+        unsigned sz = m_lemma.size();
+        unsigned j  = 1;
+        for (unsigned i = 1; i < sz; i++) {
+            if (m_ctx.is_marked(m_lemma[i].var())) {
+                if (j != i) {
+                    m_lemma[j] = m_lemma[i];
+                    m_lemma_atoms.set(j, m_lemma_atoms.get(i));
+                }
+                j++;
+            }
+        }
+        SASSERT(sz - j == num_removed);
+        m_lemma      .shrink(j);
+        m_lemma_atoms.shrink(j);
+        m_ctx.m_stats.m_num_minimized_lits += num_removed;
+    }
+
+    /**
+       \brief Recompute the glue of a lemma used in conflict resolution, and
+       keep the smaller value. Lemmas in the core tier are not updated.
+    */
+    void conflict_resolution::update_glue(clause * cls) {
+        SASSERT(cls->is_lemma());
+        if (cls->get_glue() <= m_params.m_lemma_gc_core_glue)
+            return;
+        unsigned glue = m_ctx.get_lbd(cls);
+        if (glue < cls->get_glue())
+            cls->set_glue(glue);
+    }
+
     /**
        \brief Return the proof object associated with the equality (= n1 n2)
        if it already exists. Otherwise, return 0 and add p to the todo-list.
@@ -183,6 +183,8 @@ namespace smt {
         bool_var_vector m_lemma_min_stack;
         level_approx_set m_lvl_set;
         level_approx_set get_lemma_approx_level_set();
+        void minimize_lemma_binary();
+        void update_glue(clause * cls);
         void reset_unmark(unsigned old_size);
         void reset_unmark_and_justifications(unsigned old_size, unsigned old_js_qhead);
         bool process_antecedent_for_minimization(literal antecedent);
@@ -34,6 +34,7 @@ Revision History:
 #include "smt/smt_model_generator.h"
 #include "smt/smt_model_checker.h"
 #include "smt/smt_model_finder.h"
+#include "smt/smt_parallel.h"
 #include "model/model_pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_translation.h"
@@ -74,6 +75,7 @@ namespace smt {
         m_unsat_proof(m),
         m_unknown("unknown"),
         m_unsat_core(m),
+        m_core_cache_head(0),
 #ifdef Z3DEBUG
         m_trail_enabled(true),
 #endif
@@ -223,6 +225,7 @@ namespace smt {
 
 
     context::~context() {
+        write_profile_trace();
         flush();
     }
 
@@ -1696,6 +1699,7 @@ namespace smt {
 
     bool context::propagate_theories() {
         for (theory * t : m_theory_set) {
+            scoped_profile _sp(m_profiler, PROF_THEORY_PROPAGATE, t->get_id());
             t->propagate();
             if (inconsistent())
                 return false;
@@ -1758,29 +1762,41 @@ namespace smt {
             if (inconsistent())
                 return false;
             unsigned qhead = m_qhead;
-            if (!bcp())
-                return false;
-            if (!propagate_th_case_split(qhead))
-                return false;
+            {
+                scoped_profile _sp(m_profiler, PROF_BCP);
+                if (!bcp())
+                    return false;
+                if (!propagate_th_case_split(qhead))
+                    return false;
+            }
             if (get_cancel_flag()) {
                 m_qhead = qhead;
                 return true;
             }
             SASSERT(!inconsistent());
-            propagate_relevancy(qhead);
+            {
+                scoped_profile _sp(m_profiler, PROF_RELEVANCY);
+                propagate_relevancy(qhead);
+            }
             if (inconsistent())
                 return false;
-            if (!propagate_atoms())
-                return false;
-            if (!propagate_eqs())
-                return false;
-            propagate_th_eqs();
-            propagate_th_diseqs();
+            {
+                scoped_profile _sp(m_profiler, PROF_EQ_PROPAGATION);
+                if (!propagate_atoms())
+                    return false;
+                if (!propagate_eqs())
+                    return false;
+                propagate_th_eqs();
+                propagate_th_diseqs();
+            }
             if (inconsistent())
                 return false;
             if (!propagate_theories())
                 return false;
-            m_qmanager->propagate();
+            {
+                scoped_profile _sp(m_profiler, PROF_QUANTIFIERS);
+                m_qmanager->propagate();
+            }
             if (inconsistent())
                 return false;
             if (resource_limits_exceeded()) {
@@ -1831,6 +1847,7 @@ namespace smt {
        more case splits to be performed.
     */
     bool context::decide() {
+        scoped_profile _sp(m_profiler, PROF_DECIDE);
         bool_var var;
         lbool phase;
         m_case_split_queue->next_case_split(var, phase);
@@ -2685,8 +2702,43 @@ namespace smt {
         SASSERT(check_clauses(m_lemmas) && check_clauses(m_aux_clauses));
     }
 
+    /**
+       \brief Return the literal block distance of the given literals, that is, the number of
+       distinct scope levels they were assigned at. All unassigned literals count as one level.
+    */
+    unsigned context::get_lbd(unsigned num_lits, literal const * lits) {
+        m_lbd_levels.reset();
+        unsigned r     = 0;
+        bool has_undef = false;
+        for (unsigned i = 0; i < num_lits; i++) {
+            literal l = lits[i];
+            if (get_assignment(l) == l_undef) {
+                has_undef = true;
+                continue;
+            }
+            unsigned lvl = get_assign_level(l);
+            if (!m_lbd_levels.contains(lvl)) {
+                m_lbd_levels.insert(lvl);
+                r++;
+            }
+        }
+        return has_undef ? r + 1 : r;
+    }
+
+    /**
+       \brief Order lemmas for garbage collection: lemmas in the core tier (low glue) come first,
+       then lemmas are ordered by activity.
+    */
     struct clause_lt {
-        bool operator()(clause * cls1, clause * cls2) const { return cls1->get_activity() > cls2->get_activity(); }
+        unsigned m_core_glue;
+        clause_lt(unsigned core_glue):m_core_glue(core_glue) {}
+        bool operator()(clause * cls1, clause * cls2) const { 
+            bool core1 = cls1->get_glue() <= m_core_glue;
+            bool core2 = cls2->get_glue() <= m_core_glue;
+            if (core1 != core2)
+                return core1;
+            return cls1->get_activity() > cls2->get_activity(); 
+        }
     };
 
     /**
@@ -2718,7 +2770,7 @@ namespace smt {
         SASSERT (m_fparams.m_recent_lemmas_size < sz);
         unsigned end_at        = sz - m_fparams.m_recent_lemmas_size;
         SASSERT(start_at < end_at);
-        std::stable_sort(m_lemmas.begin() + start_at, m_lemmas.begin() + end_at, clause_lt());
+        std::stable_sort(m_lemmas.begin() + start_at, m_lemmas.begin() + end_at, clause_lt(m_fparams.m_lemma_gc_core_glue));
         unsigned start_del_at  = (start_at + end_at) / 2;
         unsigned i             = start_del_at;
         unsigned j             = i;
@@ -2727,9 +2779,9 @@ namespace smt {
               << ", start_del_at: " << start_del_at << "\n";);
         for (; i < end_at; i++) {
             clause * cls = m_lemmas[i];
-            if (can_delete(cls)) {
+            if (can_delete(cls) && (cls->deleted() || cls->get_glue() > m_fparams.m_lemma_gc_core_glue)) {
                 TRACE("del_inactive_lemmas", tout << "deleting: "; display_clause(tout, cls); tout << ", activity: " <<
-                      cls->get_activity() << "\n";);
+                      cls->get_activity() << ", glue: " << cls->get_glue() << "\n";);
                 del_clause(cls);
                 num_del_cls++;
             }
@@ -2767,6 +2819,8 @@ namespace smt {
        A clause is deleted/retained based on its activity and relevancy. Clauses with several
        unassigned literals are considered less relevant. The threshold used for activity and relevancy
        depends on which group the clauses is in.
+       Lemmas are also divided in tiers by glue: lemmas in the core tier are always retained, and
+       lemmas in the second tier are treated as new clauses regardless of their age.
     */
     void context::del_inactive_lemmas2() {
         IF_VERBOSE(2, verbose_stream() << "(smt.delete-inactive-clauses "; verbose_stream().flush(););
@@ -2789,12 +2843,19 @@ namespace smt {
                     num_del_cls++;
                     continue;
                 }
+                unsigned glue = cls->get_glue();
+                if (glue <= m_fparams.m_lemma_gc_core_glue) {
+                    m_lemmas[j++] = cls;
+                    continue;
+                }
+                bool tier2 = glue <= m_fparams.m_lemma_gc_tier2_glue;
                 // A clause is deleted if it has low activity and the number of unknowns is greater than a threshold.
                 // The activity threshold depends on how old the clause is.
-                unsigned act_threshold = m_fparams.m_old_clause_activity -
+                unsigned act_threshold = tier2 ? m_fparams.m_new_clause_activity : 
+                    m_fparams.m_old_clause_activity -
                     (m_fparams.m_old_clause_activity - m_fparams.m_new_clause_activity) * ((i - start_at) / real_sz);
                 if (cls->get_activity() < act_threshold) {
-                    unsigned rel_threshold = (i >= new_first_idx ? m_fparams.m_new_clause_relevancy : m_fparams.m_old_clause_relevancy);
+                    unsigned rel_threshold = (tier2 || i >= new_first_idx ? m_fparams.m_new_clause_relevancy : m_fparams.m_old_clause_relevancy);
                     if (more_than_k_unassigned_literals(cls, rel_threshold)) {
                         del_clause(cls);
                         num_del_cls++;
@@ -2863,6 +2924,7 @@ namespace smt {
         SASSERT(!already_internalized_theory(th));
         th->init(this);
         m_theories.register_plugin(th);
+        m_profiler.register_theory(th->get_id(), th->get_name());
         m_theory_set.push_back(th);
         {
 #ifdef Z3DEBUG
@@ -2899,6 +2961,8 @@ namespace smt {
     void context::pop(unsigned num_scopes) {
         SASSERT (num_scopes > 0);
         if (num_scopes > m_scope_lvl) return;
+        m_core_cache.reset();
+        m_core_cache_head = 0;
         pop_to_base_lvl();
         pop_scope(num_scopes);
     }
@@ -3228,6 +3292,7 @@ namespace smt {
             m_last_search_failure = MEMOUT;
             return false;
         }
+        m_profiler.updt_params(m_fparams.m_profile, m_fparams.m_profile_max_events);
         return true;
     }
 
@@ -3366,6 +3431,15 @@ namespace smt {
             if (m_asserted_formulas.inconsistent()) {
                 r = l_false;
             }
+            else if (find_cached_core(all_assumptions)) {
+                r = l_false;
+            }
+            else if (use_parallel()) {
+                parallel p(*this);
+                r = p(expr_ref_vector(m_manager, ext_num_assumptions, ext_assumptions));
+                if (r == l_false)
+                    cache_core();
+            }
             else {
                 init_assumptions(num_assumptions, assumptions);
                 TRACE("after_internalization", display(tout););
@@ -3387,12 +3461,70 @@ namespace smt {
                         }
                     }
                 }
+                if (r == l_false)
+                    cache_core();
             }
         }
         r = check_finalize(r);
         return r;
     }
 
+    /**
+       \brief Return true if a cached unsat core is contained in the given assumptions.
+       The core is then stored in m_unsat_core.
+       Cores remain valid when assertions are added, and are discarded on pop.
+    */
+    bool context::find_cached_core(expr_ref_vector const & assumptions) {
+        if (m_core_cache.empty() || assumptions.empty())
+            return false;
+        obj_hashtable<expr> asms;
+        for (expr * a : assumptions)
+            asms.insert(a);
+        for (expr_ref_vector const & core : m_core_cache) {
+            bool found = true;
+            for (expr * c : core) {
+                if (!asms.contains(c)) {
+                    found = false;
+                    break;
+                }
+            }
+            if (found) {
+                TRACE("unsat_core", tout << "cached core: " << core << "\n";);
+                m_stats.m_num_cached_cores++;
+                m_unsat_core.reset();
+                m_unsat_core.append(core);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void context::cache_core() {
+        if (m_fparams.m_core_cache_size == 0 || m_unsat_core.empty() || m_manager.proofs_enabled())
+            return;
+        if (m_core_cache.size() < m_fparams.m_core_cache_size) {
+            m_core_cache.push_back(m_unsat_core);
+            return;
+        }
+        expr_ref_vector & core = m_core_cache[m_core_cache_head];
+        core.reset();
+        core.append(m_unsat_core);
+        m_core_cache_head = (m_core_cache_head + 1) % m_core_cache.size();
+    }
+
+    /**
+       \brief Return true if the search should be delegated to parallel copies of this context.
+       Contexts inside user scopes cannot be copied, and proofs are not transferred between copies.
+    */
+    bool context::use_parallel() const {
+        return 
+            m_fparams.m_threads > 1 && 
+            m_base_lvl == 0 && 
+            !m_manager.proofs_enabled() && 
+            !m_manager.has_trace_stream() &&
+            !inconsistent();
+    }
+
     void context::init_search() {
         for (theory* th : m_theory_set) {
             th->init_search_eh();
@@ -3712,7 +3844,11 @@ namespace smt {
 
         m_stats.m_num_final_checks++;
 
-        final_check_status ok = m_qmanager->final_check_eh(false);
+        final_check_status ok;
+        {
+            scoped_profile _sp(m_profiler, PROF_QUANTIFIERS);
+            ok = m_qmanager->final_check_eh(false);
+        }
         if (ok != FC_DONE)
             return ok;
 
@@ -3730,6 +3866,7 @@ namespace smt {
             if (m_final_check_idx < num_th) {
                 theory * th = m_theory_set[m_final_check_idx];
                 IF_VERBOSE(100, verbose_stream() << "(smt.final-check \"" << th->get_name() << "\")\n";);
+                scoped_profile _sp(m_profiler, PROF_FINAL_CHECK, th->get_id());
                 ok = th->final_check_eh();
                 TRACE("final_check_step", tout << "final check '" << th->get_name() << " ok: " << ok << " inconsistent " << inconsistent() << "\n";);
                 if (ok == FC_GIVEUP) {
@@ -3738,6 +3875,7 @@ namespace smt {
                 }
             }
             else {
+                scoped_profile _sp(m_profiler, PROF_QUANTIFIERS);
                 ok = m_qmanager->final_check_eh(true);
                 TRACE("final_check_step", tout << "quantifier  ok: " << ok << " " << "inconsistent " << inconsistent() << "\n";);
             }
@@ -3792,6 +3930,7 @@ namespace smt {
     }
 
     bool context::resolve_conflict() {
+        scoped_profile _sp(m_profiler, PROF_CONFLICT);
         m_stats.m_num_conflicts++;
         m_num_conflicts ++;
         m_num_conflicts_since_restart ++;
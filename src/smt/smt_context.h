@@ -31,6 +31,7 @@ Revision History:
 #include "smt/smt_quantifier.h"
 #include "smt/smt_quantifier_stat.h"
 #include "smt/smt_statistics.h"
+#include "smt/smt_profiler.h"
 #include "smt/smt_conflict_resolution.h"
 #include "smt/smt_relevancy.h"
 #include "smt/smt_case_split_queue.h"
@@ -66,8 +67,10 @@ namespace smt {
 
     class context {
         friend class model_generator;
+        friend class parallel;
     public:
         statistics                  m_stats;
+        profiler                    m_profiler;
 
         std::ostream& display_last_failure(std::ostream& out) const;
         std::string last_failure_as_string() const;
@@ -164,6 +167,7 @@ namespace smt {
         svector<double>             m_activity;
         clause_vector               m_aux_clauses;
         clause_vector               m_lemmas;
+        uint_set                    m_lbd_levels;  //!< auxiliary set used to compute the glue of lemmas
         vector<clause_vector>       m_clauses_to_reinit;
         expr_ref_vector             m_units_to_reassert;
         svector<char>               m_units_to_reassert_sign;
@@ -230,6 +234,8 @@ namespace smt {
         literal_vector             m_assumptions;
         literal2assumption         m_literal2assumption; // maps an expression associated with a literal to the original assumption
         expr_ref_vector            m_unsat_core;
+        vector<expr_ref_vector>    m_core_cache;         // unsat cores over assumptions, discarded on pop
+        unsigned                   m_core_cache_head;
 
         // -----------------------------------
         //
@@ -443,6 +449,12 @@ namespace smt {
             return get_assign_level(l.var());
         }
 
+        unsigned get_lbd(unsigned num_lits, literal const * lits);
+
+        unsigned get_lbd(clause const * cls) {
+            return get_lbd(cls->get_num_literals(), cls->begin_literals());
+        }
+
         /**
            \brief Return the scope level when v was internalized.
         */
@@ -1316,6 +1328,8 @@ namespace smt {
 
         void display_profile(std::ostream & out) const;
 
+        void write_profile_trace() const;
+
         void display(std::ostream& out, b_justification j) const;
 
         // -----------------------------------
@@ -1399,6 +1413,12 @@ namespace smt {
         bool check_preamble(bool reset_cancel);
         lbool check_finalize(lbool r);
 
+        bool use_parallel() const;
+
+        bool find_cached_core(expr_ref_vector const & assumptions);
+
+        void cache_core();
+
         // -----------------------------------
         //
         // API
@@ -371,6 +371,7 @@ namespace smt {
         st.update("max generation", m_stats.m_max_generation);
         st.update("minimized lits", m_stats.m_num_minimized_lits);
         st.update("num checks", m_stats.m_num_checks);
+        st.update("cached cores", m_stats.m_num_cached_cores);
         st.update("mk bool var", m_stats.m_num_mk_bool_var);
 
 #if 0
@@ -385,6 +386,7 @@ namespace smt {
         st.update("backwd subs res", m_stats.m_num_bsr);
         st.update("frwrd subs res", m_stats.m_num_fsr);
 #endif
+        m_profiler.collect_statistics(st);
         m_qmanager->collect_statistics(st);
         m_asserted_formulas.collect_statistics(st);
         for (theory* th : m_theory_set) {
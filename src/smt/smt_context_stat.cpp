@@ -155,5 +155,15 @@ namespace smt {
     void context::display_profile(std::ostream & out) const {
         if (m_fparams.m_profile_res_sub)
             display_profile_res_sub(out);
+        if (m_fparams.m_profile) 
+            IF_VERBOSE(1, m_profiler.display(out););
+    }
+
+    /**
+       \brief Write the timeline of the search, once for the lifetime of the context.
+    */
+    void context::write_profile_trace() const {
+        if (m_profiler.enabled() && m_fparams.m_profile_trace_file != symbol::null && m_fparams.m_profile_trace_file != symbol(""))
+            m_profiler.write_chrome_trace(m_fparams.m_profile_trace_file.str());
     }
 };
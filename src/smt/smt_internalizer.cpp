@@ -1333,6 +1333,7 @@ namespace smt {
             clause * cls = clause::mk(m_manager, num_lits, lits, k, j, del_eh, save_atoms, m_bool_var2expr.c_ptr());
             if (lemma) {
                 cls->set_activity(activity);
+                cls->set_glue(get_lbd(cls));
                 if (k == CLS_LEARNED) {
                     int w2_idx  = select_learned_watch_lit(cls);
                     cls->swap_lits(1, w2_idx);
@@ -0,0 +1,260 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    smt_parallel.cpp
+
+Abstract:
+
+    Portfolio mode for the SMT context.
+
+    The context is copied into ctx.get_fparams().m_threads fresh managers.
+    The copies use different random seeds, case split and phase selection
+    strategies and arithmetic initial values. They search in rounds bounded
+    by a number of conflicts. Between rounds, units and short lemmas over the
+    symbols of the input are exchanged through ast_translation. The first
+    copy that produces an answer cancels the others.
+
+Revision History:
+
+--*/
+#include "util/z3_omp.h"
+#include "util/scoped_ptr_vector.h"
+#include "ast/ast_translation.h"
+#include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
+#include "smt/smt_parallel.h"
+#include "smt/smt_context.h"
+
+namespace smt {
+
+    enum par_exception_kind {
+        NO_EX,
+        DEFAULT_EX,
+        ERROR_EX
+    };
+
+    /**
+       \brief Fresh (skolem) symbols are created independently in each copy,
+       so only ground formulas over the symbols of the input are exchanged.
+    */
+    struct non_sharable_proc {
+        struct found {};
+        void operator()(var * n) { throw found(); }
+        void operator()(quantifier * n) { throw found(); }
+        void operator()(app * n) { if (n->get_decl()->is_skolem()) throw found(); }
+    };
+
+    static bool is_sharable(expr * e) {
+        non_sharable_proc proc;
+        try {
+            for_each_expr(proc, e);
+        }
+        catch (non_sharable_proc::found) {
+            return false;
+        }
+        return true;
+    }
+
+    static void diversify(smt_params & p, unsigned i) {
+        static case_split_strategy const css[4] = {
+            CS_ACTIVITY_DELAY_NEW, CS_ACTIVITY, CS_RELEVANCY_ACTIVITY, CS_ACTIVITY_WITH_CACHE
+        };
+        p.m_threads                   = 1;
+        // the profile of a copy is discarded with it, and all copies would write the same trace file.
+        p.m_profile                   = false;
+        p.m_random_seed              += i;
+        p.m_arith_random_seed        += i;
+        if (i == 0)
+            return;
+        p.m_case_split_strategy       = css[i % 4];
+        p.m_phase_selection           = (i % 2 == 0) ? PS_CACHING_CONSERVATIVE : PS_CACHING;
+        p.m_arith_random_initial_value = (i % 2 == 1);
+    }
+
+    lbool parallel::operator()(expr_ref_vector const& asms) {
+        ast_manager& m  = ctx.get_manager();
+        smt_params& fp  = ctx.get_fparams();
+        unsigned num_threads = fp.m_threads;
+        scoped_ptr_vector<ast_manager> pms;
+        scoped_ptr_vector<smt_params>  pparams;
+        scoped_ptr_vector<context>     pctxs;
+        vector<expr_ref_vector>        pasms;
+        scoped_limits                  sl(m.limit());
+        // units and lemmas exchanged between the copies, in the manager of ctx.
+        expr_ref_vector                shared(m);
+        obj_hashtable<expr>            shared_set;
+        unsigned_vector                shared_lim;
+
+        for (unsigned i = 0; i < num_threads; ++i) {
+            smt_params * p = alloc(smt_params, fp);
+            diversify(*p, i);
+            pparams.push_back(p);
+            ast_manager * pm = alloc(ast_manager, m, true);
+            pms.push_back(pm);
+            context * pctx = alloc(context, *pm, *p, ctx.get_params());
+            pctxs.push_back(pctx);
+            context::copy(ctx, *pctx);
+            ast_translation tr(m, *pm, false);
+            expr_ref_vector pasm(*pm);
+            for (expr * a : asms)
+                pasm.push_back(tr(a));
+            pasms.push_back(pasm);
+            sl.push_child(&(pm->limit()));
+            shared_lim.push_back(0);
+        }
+
+        unsigned max_conflicts = fp.m_threads_max_conflicts;
+        unsigned num_conflicts = 0;
+        unsigned round         = 0;
+        while (true) {
+            unsigned budget = std::min(max_conflicts, fp.m_max_conflicts - num_conflicts);
+            for (unsigned i = 0; i < num_threads; ++i)
+                pparams[i]->m_max_conflicts = budget;
+
+            unsigned finished_id       = UINT_MAX;
+            unsigned undef_id          = UINT_MAX;
+            lbool result               = l_undef;
+            par_exception_kind ex_kind = NO_EX;
+            std::string        ex_msg;
+            unsigned           error_code = 0;
+
+            #pragma omp parallel for
+            for (int i = 0; i < static_cast<int>(num_threads); ++i) {
+                context & pctx = *pctxs[i];
+                try {
+                    lbool r = pctx.check(pasms[i].size(), pasms[i].c_ptr());
+                    if (r == l_undef && pctx.get_last_search_failure() == NUM_CONFLICTS)
+                        continue;
+                    bool first = false;
+                    #pragma omp critical (smt_parallel)
+                    {
+                        if (r == l_undef)
+                            undef_id = i;
+                        else if (finished_id == UINT_MAX) {
+                            finished_id = i;
+                            result = r;
+                            first = true;
+                        }
+                    }
+                    if (first) {
+                        for (unsigned j = 0; j < num_threads; ++j) {
+                            if (static_cast<unsigned>(i) != j)
+                                pms[j]->limit().cancel();
+                        }
+                    }
+                }
+                catch (z3_error & err) {
+                    #pragma omp critical (smt_parallel)
+                    {
+                        ex_kind = ERROR_EX;
+                        error_code = err.error_code();
+                    }
+                }
+                catch (z3_exception & ex) {
+                    #pragma omp critical (smt_parallel)
+                    {
+                        ex_kind = DEFAULT_EX;
+                        ex_msg = ex.msg();
+                    }
+                }
+            }
+
+            if (finished_id == UINT_MAX && undef_id != UINT_MAX)
+                finished_id = undef_id;
+
+            if (finished_id != UINT_MAX) {
+                context & pctx = *pctxs[finished_id];
+                ast_translation tr(*pms[finished_id], m, false);
+                IF_VERBOSE(1, verbose_stream() << "(smt.parallel :round " << round << " :thread " << finished_id << " :result " << result << ")\n";);
+                switch (result) {
+                case l_true: {
+                    model_ref mdl;
+                    pctx.get_model(mdl);
+                    if (mdl)
+                        ctx.m_model = mdl->translate(tr);
+                    break;
+                }
+                case l_false: {
+                    obj_hashtable<expr> asm_set;
+                    for (expr * a : asms)
+                        asm_set.insert(a);
+                    for (expr * c : pctx.m_unsat_core) {
+                        expr_ref e(tr(c), m);
+                        if (asm_set.contains(e))
+                            ctx.m_unsat_core.push_back(e);
+                    }
+                    break;
+                }
+                default:
+                    ctx.m_last_search_failure = pctx.get_last_search_failure();
+                    break;
+                }
+                return result;
+            }
+
+            switch (ex_kind) {
+            case ERROR_EX: throw z3_error(error_code);
+            case DEFAULT_EX: throw default_exception(ex_msg.c_str());
+            default: break;
+            }
+
+            num_conflicts += budget;
+            if (num_conflicts >= fp.m_max_conflicts) {
+                ctx.m_last_search_failure = NUM_CONFLICTS;
+                return l_undef;
+            }
+
+            // collect units and short lemmas
+            for (unsigned i = 0; i < num_threads; ++i) {
+                context & pctx   = *pctxs[i];
+                ast_manager & pm = *pms[i];
+                ast_translation tr(pm, m, false);
+                expr_ref_vector fmls(pm);
+                for (literal lit : pctx.m_assigned_literals) {
+                    if (pctx.get_assign_level(lit) > 0)
+                        continue;
+                    expr_ref e(pm);
+                    pctx.literal2expr(lit, e);
+                    fmls.push_back(e);
+                }
+                for (clause * cls : pctx.m_lemmas) {
+                    unsigned sz = cls->get_num_literals();
+                    if (sz > fp.m_threads_max_lemma_size)
+                        continue;
+                    expr_ref_vector lits(pm);
+                    for (unsigned j = 0; j < sz; ++j) {
+                        expr_ref e(pm);
+                        pctx.literal2expr(cls->get_literal(j), e);
+                        lits.push_back(e);
+                    }
+                    fmls.push_back(mk_or(lits));
+                }
+                for (expr * e : fmls) {
+                    if (pm.is_true(e) || !is_sharable(e))
+                        continue;
+                    expr_ref ce(tr(e), m);
+                    if (!shared_set.contains(ce)) {
+                        shared_set.insert(ce);
+                        shared.push_back(ce);
+                    }
+                }
+            }
+
+            // distribute them
+            for (unsigned i = 0; i < num_threads; ++i) {
+                ast_translation tr(m, *pms[i], false);
+                for (unsigned j = shared_lim[i]; j < shared.size(); ++j)
+                    pctxs[i]->assert_expr(tr(shared.get(j)));
+                shared_lim[i] = shared.size();
+            }
+
+            IF_VERBOSE(1, verbose_stream() << "(smt.parallel :round " << round << " :shared " << shared.size() << " :max-conflicts " << max_conflicts << ")\n";);
+            ++round;
+            if (max_conflicts < UINT_MAX / 2)
+                max_conflicts *= 2;
+        }
+    }
+
+};
@@ -0,0 +1,42 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    smt_parallel.h
+
+Abstract:
+
+    Portfolio mode for the SMT context: run diversified copies of a
+    context in parallel and exchange units and short lemmas between them.
+
+Revision History:
+
+--*/
+#ifndef SMT_PARALLEL_H_
+#define SMT_PARALLEL_H_
+
+#include "ast/ast.h"
+#include "util/lbool.h"
+
+namespace smt {
+
+    class context;
+
+    class parallel {
+        context& ctx;
+    public:
+        parallel(context& ctx): ctx(ctx) {}
+
+        /**
+           \brief Check satisfiability of the assertions in ctx modulo asms
+           using ctx.get_fparams().m_threads diversified copies of ctx.
+           The model or unsat core of the first copy that finishes is
+           transferred back to ctx.
+        */
+        lbool operator()(expr_ref_vector const& asms);
+    };
+
+};
+
+#endif /* SMT_PARALLEL_H_ */
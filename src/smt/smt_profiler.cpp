@@ -0,0 +1,195 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    smt_profiler.cpp
+
+Abstract:
+
+    Time attribution for the phases of the SMT search.
+
+Revision History:
+
+--*/
+#include<iomanip>
+#include<fstream>
+#include<sstream>
+#ifndef _WINDOWS
+#include<unistd.h>
+#else
+#include<process.h>
+#endif
+#include "util/z3_omp.h"
+#include "util/warning.h"
+#include "smt/smt_profiler.h"
+
+namespace smt {
+
+    static char const * g_phase_names[PROF_NUM_PHASES] = {
+        "bcp",
+        "relevancy",
+        "eq propagation",
+        "theory propagate",
+        "quantifiers",
+        "final check",
+        "decide",
+        "conflict"
+    };
+
+    void profiler::entry::reset() {
+        m_count = 0;
+        m_time  = 0;
+        m_max   = 0;
+        for (unsigned i = 0; i < NUM_BUCKETS; ++i)
+            m_hist[i] = 0;
+    }
+
+    profiler::profiler():
+        m_enabled(false),
+        m_max_events(0),
+        m_epoch(std::chrono::steady_clock::now()),
+        m_num_dropped(0) {
+        m_entries.resize(PROF_NUM_PHASES);
+    }
+
+    void profiler::updt_params(bool enabled, unsigned max_events) {
+        m_enabled    = enabled;
+        m_max_events = max_events;
+    }
+
+    void profiler::register_theory(theory_id th, char const * name) {
+        m_theory_names.reserve(th + 2, nullptr);
+        m_theory_names[th + 1] = name;
+    }
+
+    char const * profiler::get_theory_name(theory_id th) const {
+        char const * r = m_theory_names.get(th + 1, nullptr);
+        return r ? r : "core";
+    }
+
+    profiler::entry & profiler::get_entry(unsigned ph, theory_id th) {
+        svector<entry> & es = m_entries[ph];
+        unsigned idx = static_cast<unsigned>(th + 1);
+        if (idx >= es.size())
+            es.resize(idx + 1);
+        return es[idx];
+    }
+
+    unsigned profiler::get_bucket(double secs) {
+        double us = secs * 1000000.0;
+        unsigned b = 0;
+        double limit = 1.0;
+        while (b + 1 < NUM_BUCKETS && us >= limit) {
+            limit *= 2.0;
+            ++b;
+        }
+        return b;
+    }
+
+    void profiler::record(unsigned ph, theory_id th, double start) {
+        double duration = now() - start;
+        entry & e = get_entry(ph, th);
+        e.m_count++;
+        e.m_time += duration;
+        if (duration > e.m_max)
+            e.m_max = duration;
+        e.m_hist[get_bucket(duration)]++;
+        if (m_events.size() < m_max_events)
+            m_events.push_back(event(ph, th, start, duration));
+        else
+            m_num_dropped++;
+    }
+
+    void profiler::reset() {
+        for (svector<entry> & es : m_entries)
+            es.reset();
+        m_events.reset();
+        m_num_dropped = 0;
+    }
+
+    void profiler::collect_statistics(::statistics & st) const {
+        if (!m_enabled)
+            return;
+        for (unsigned ph = 0; ph < PROF_NUM_PHASES; ++ph) {
+            double time = 0;
+            for (entry const & e : m_entries[ph])
+                time += e.m_time;
+            std::string name = std::string("time ") + g_phase_names[ph];
+            st.update(name.c_str(), time);
+        }
+    }
+
+    void profiler::display(std::ostream & out) const {
+        if (!m_enabled)
+            return;
+        std::streamsize prec = out.precision();
+        out << "(smt.profile\n";
+        for (unsigned ph = 0; ph < PROF_NUM_PHASES; ++ph) {
+            svector<entry> const & es = m_entries[ph];
+            for (unsigned i = 0; i < es.size(); ++i) {
+                entry const & e = es[i];
+                if (e.m_count == 0)
+                    continue;
+                theory_id th = static_cast<theory_id>(i) - 1;
+                out << "  (" << std::setw(16) << std::left << g_phase_names[ph] << " "
+                    << std::setw(10) << get_theory_name(th)
+                    << " :count " << std::setw(8) << e.m_count
+                    << " :time " << std::fixed << std::setprecision(3) << e.m_time
+                    << " :avg-us " << std::setprecision(2) << (e.m_time * 1000000.0 / e.m_count)
+                    << " :max-us " << std::setprecision(2) << (e.m_max * 1000000.0)
+                    << std::right << ")\n";
+                out.unsetf(std::ios::floatfield);
+                out << "   ";
+                for (unsigned b = 0; b < NUM_BUCKETS; ++b)
+                    out << " " << e.m_hist[b];
+                out << "\n";
+            }
+        }
+        if (m_num_dropped > 0)
+            out << "  (:dropped-events " << m_num_dropped << ")\n";
+        out << ")\n";
+        out.precision(prec);
+    }
+
+    void profiler::display_chrome_trace(std::ostream & out) const {
+        std::streamsize prec = out.precision();
+        out << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (event const & ev : m_events) {
+            if (!first)
+                out << ",\n";
+            first = false;
+            out << "{\"name\":\"" << g_phase_names[ev.m_phase]
+                << "\",\"cat\":\"" << get_theory_name(ev.m_th_id)
+                << "\",\"ph\":\"X\",\"ts\":" << std::fixed << std::setprecision(3) << (ev.m_start * 1000000.0)
+                << ",\"dur\":" << (ev.m_duration * 1000000.0)
+                << ",\"pid\":1,\"tid\":1}";
+        }
+        out.unsetf(std::ios::floatfield);
+        out.precision(prec);
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+    void profiler::write_chrome_trace(std::string const & file_name) const {
+        static unsigned s_num_traces = 0;
+        unsigned idx;
+        #pragma omp critical (smt_profiler)
+        {
+            idx = s_num_traces++;
+        }
+#ifdef _WINDOWS
+        int pid = _getpid();
+#else
+        int pid = getpid();
+#endif
+        std::ostringstream strm;
+        strm << file_name << "." << pid << "." << idx;
+        std::ofstream trace(strm.str());
+        if (trace) 
+            display_chrome_trace(trace);
+        else
+            warning_msg("could not open file '%s' for writing the search trace", strm.str().c_str());
+    }
+
+};
@@ -0,0 +1,148 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    smt_profiler.h
+
+Abstract:
+
+    Time attribution for the phases of the SMT search.
+
+    The profiler accumulates, per phase and per theory, the number of
+    invocations, the total time and a histogram of durations. It also
+    records a bounded timeline of events that can be written in the
+    Chrome trace event format (chrome://tracing, Perfetto). Times are
+    measured with a monotonic wall clock.
+
+    Instrumentation is done with scoped_profile. When the profiler is
+    disabled it costs a test of a Boolean flag.
+
+Revision History:
+
+--*/
+#ifndef SMT_PROFILER_H_
+#define SMT_PROFILER_H_
+
+#include<ostream>
+#include<chrono>
+#include "util/vector.h"
+#include "util/statistics.h"
+#include "ast/ast.h"
+#include "smt/smt_types.h"
+
+namespace smt {
+
+    enum profile_phase {
+        PROF_BCP,
+        PROF_RELEVANCY,
+        PROF_EQ_PROPAGATION,
+        PROF_THEORY_PROPAGATE,
+        PROF_QUANTIFIERS,
+        PROF_FINAL_CHECK,
+        PROF_DECIDE,
+        PROF_CONFLICT,
+        PROF_NUM_PHASES
+    };
+
+    class profiler {
+    public:
+        // bucket i contains the events of duration in [2^(i-1), 2^i) microseconds.
+        static const unsigned NUM_BUCKETS = 16;
+
+    private:
+        struct entry {
+            unsigned m_count;
+            double   m_time;
+            double   m_max;
+            unsigned m_hist[NUM_BUCKETS];
+            entry() { reset(); }
+            void reset();
+        };
+
+        struct event {
+            unsigned  m_phase;
+            theory_id m_th_id;
+            double    m_start;
+            double    m_duration;
+            event(unsigned ph, theory_id th, double start, double duration):
+                m_phase(ph), m_th_id(th), m_start(start), m_duration(duration) {}
+        };
+
+        bool                  m_enabled;
+        unsigned              m_max_events;
+        std::chrono::steady_clock::time_point m_epoch;
+        vector<svector<entry> > m_entries;       // phase -> theory id + 1 -> entry
+        svector<event>        m_events;
+        unsigned              m_num_dropped;
+        ptr_vector<char const> m_theory_names;   // theory id + 1 -> name
+
+        entry & get_entry(unsigned ph, theory_id th);
+        char const * get_theory_name(theory_id th) const;
+        static unsigned get_bucket(double secs);
+
+    public:
+        profiler();
+
+        bool enabled() const { return m_enabled; }
+
+        void updt_params(bool enabled, unsigned max_events);
+
+        void register_theory(theory_id th, char const * name);
+
+        /**
+           \brief Wall clock time, in seconds, since the profiler was created.
+        */
+        double now() const { 
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_epoch).count(); 
+        }
+
+        void record(unsigned ph, theory_id th, double start);
+
+        void reset();
+
+        void collect_statistics(::statistics & st) const;
+
+        /**
+           \brief Display a table with the count, total, average and maximal time of each phase,
+           followed by the histogram of durations.
+        */
+        void display(std::ostream & out) const;
+
+        /**
+           \brief Write the recorded events in the Chrome trace event (JSON) format.
+        */
+        void display_chrome_trace(std::ostream & out) const;
+
+        /**
+           \brief Write the recorded events to a file whose name is obtained from \c file_name
+           by appending the process id and a sequence number, so that the contexts of a process 
+           and different processes do not overwrite each other's traces.
+        */
+        void write_chrome_trace(std::string const & file_name) const;
+    };
+
+    class scoped_profile {
+        profiler * m_profiler;
+        unsigned   m_phase;
+        theory_id  m_th_id;
+        double     m_start;
+    public:
+        scoped_profile(profiler & p, profile_phase ph, theory_id th = null_theory_id):
+            m_profiler(nullptr) {
+            if (p.enabled()) {
+                m_profiler = &p;
+                m_phase    = ph;
+                m_th_id    = th;
+                m_start    = p.now();
+            }
+        }
+        ~scoped_profile() {
+            if (m_profiler)
+                m_profiler->record(m_phase, m_th_id, m_start);
+        }
+    };
+
+};
+
+#endif /* SMT_PROFILER_H_ */
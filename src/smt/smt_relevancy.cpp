@@ -21,6 +21,7 @@ Revision History:
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
+#include "util/bit_vector.h"
 
 namespace smt {
 
@@ -126,13 +127,24 @@ namespace smt {
         return mk_relevancy_eh(ite_term_relevancy_eh(c, t, e));
     }
     
+    /**
+       \brief Relevancy marks, handlers and watches are indexed by expression id.
+       
+       Relevancy marks are stored in a bit-vector, and handlers/watches are stored
+       in vectors. So, checking whether an expression is relevant or has watches
+       attached to it does not require hashing. Watches on and/or-parents are lazy:
+       once a relevant parent is justified (i.e., the children that make it relevant
+       were marked), the watches become no-ops until the justification is backtracked.
+    */
     struct relevancy_propagator_imp : public relevancy_propagator {
         unsigned                       m_qhead;
         expr_ref_vector                m_relevant_exprs; 
-        obj_hashtable<expr>            m_is_relevant;
+        bit_vector                     m_is_relevant;
         typedef list<relevancy_eh *>   relevancy_ehs;
-        obj_map<expr, relevancy_ehs *> m_relevant_ehs;
-        obj_map<expr, relevancy_ehs *> m_watches[2];
+        ptr_vector<relevancy_ehs>      m_relevant_ehs;
+        ptr_vector<relevancy_ehs>      m_watches[2];
+        bit_vector                     m_justified;
+        unsigned_vector                m_justified_trail;
         struct eh_trail {
             enum kind { POS_WATCH, NEG_WATCH, HANDLER };
             kind   m_kind;
@@ -146,6 +158,7 @@ namespace smt {
         struct scope {
             unsigned m_relevant_exprs_lim;
             unsigned m_trail_lim;
+            unsigned m_justified_lim;
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating;
@@ -159,31 +172,35 @@ namespace smt {
         }
 
         relevancy_ehs * get_handlers(expr * n) {
-            relevancy_ehs * r = nullptr;
-            m_relevant_ehs.find(n, r);
-            SASSERT(m_relevant_ehs.contains(n) || r == 0);
-            return r;
+            return m_relevant_ehs.get(n->get_id(), nullptr);
         }
 
         void set_handlers(expr * n, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_relevant_ehs.erase(n);
-            else
-                m_relevant_ehs.insert(n, ehs);
+            m_relevant_ehs.setx(n->get_id(), ehs, nullptr);
         }
 
         relevancy_ehs * get_watches(expr * n, bool val) {
-            relevancy_ehs * r = nullptr;
-            m_watches[val ? 1 : 0].find(n, r);
-            SASSERT(m_watches[val ? 1 : 0].contains(n) || r == 0);
-            return r;
+            return m_watches[val ? 1 : 0].get(n->get_id(), nullptr);
         }
 
         void set_watches(expr * n, bool val, relevancy_ehs * ehs) {
-            if (ehs == nullptr)
-                m_watches[val ? 1 : 0].erase(n);
-            else
-                m_watches[val ? 1 : 0].insert(n, ehs);
+            m_watches[val ? 1 : 0].setx(n->get_id(), ehs, nullptr);
+        }
+
+        bool is_justified(expr * n) const {
+            unsigned id = n->get_id();
+            return id < m_justified.size() && m_justified.get(id);
+        }
+
+        /**
+           \brief Record that the relevancy of the children of the and/or-application n 
+           has been propagated. The mark is removed when the current scope is backtracked.
+        */
+        void set_justified(expr * n) {
+            unsigned id = n->get_id();
+            m_justified.reserve(id + 1, false);
+            m_justified.set(id);
+            m_justified_trail.push_back(id);
         }
 
         void push_trail(eh_trail const & t) {
@@ -242,7 +259,10 @@ namespace smt {
             }
         }
         
-        bool is_relevant_core(expr * n) const { return m_is_relevant.contains(n); }
+        bool is_relevant_core(expr * n) const { 
+            unsigned id = n->get_id();
+            return id < m_is_relevant.size() && m_is_relevant.get(id); 
+        }
         
         bool is_relevant(expr * n) const override {
             return !enabled() || is_relevant_core(n);
@@ -253,6 +273,7 @@ namespace smt {
             scope & s                  = m_scopes.back();
             s.m_relevant_exprs_lim     = m_relevant_exprs.size();
             s.m_trail_lim              = m_trail.size();
+            s.m_justified_lim          = m_justified_trail.size();
         }
 
         void pop(unsigned num_scopes) override {
@@ -263,6 +284,7 @@ namespace smt {
             scope & s        = m_scopes[new_lvl];
             unmark_relevant_exprs(s.m_relevant_exprs_lim);
             undo_trail(s.m_trail_lim);
+            unmark_justified(s.m_justified_lim);
             m_scopes.shrink(new_lvl);
         }
 
@@ -275,13 +297,20 @@ namespace smt {
             while (i != old_lim) {
                 --i;
                 expr * n = m_relevant_exprs.get(i);
-                m_is_relevant.erase(n);
+                m_is_relevant.unset(n->get_id());
                 TRACE("propagate_relevancy", tout << "unmarking:\n" << mk_ismt2_pp(n, get_manager()) << "\n";);
             }
             m_relevant_exprs.shrink(old_lim);
             m_qhead = m_relevant_exprs.size();
         }
 
+        void unmark_justified(unsigned old_lim) {
+            SASSERT(old_lim <= m_justified_trail.size());
+            for (unsigned i = old_lim; i < m_justified_trail.size(); i++) 
+                m_justified.unset(m_justified_trail[i]);
+            m_justified_trail.shrink(old_lim);
+        }
+
         void undo_trail(unsigned old_lim) {
             SASSERT(old_lim <= m_trail.size());
             ast_manager & m = get_manager();
@@ -303,7 +332,9 @@ namespace smt {
         }
 
         void set_relevant(expr * n) {
-            m_is_relevant.insert(n);
+            unsigned id = n->get_id();
+            m_is_relevant.reserve(id + 1, false);
+            m_is_relevant.set(id);
             m_relevant_exprs.push_back(n);
             m_context.relevant_eh(n);
         }
@@ -363,6 +394,8 @@ namespace smt {
         */
         void propagate_relevant_or(app * n) {
             SASSERT(get_manager().is_or(n));
+            if (is_justified(n))
+                return;
             
             lbool val    = m_context.find_assignment(n);
             // If val is l_undef, then the expression
@@ -372,6 +405,7 @@ namespace smt {
             switch (val) {
             case l_false:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             case l_undef:
                 break;
@@ -381,14 +415,18 @@ namespace smt {
                 for (unsigned i = 0; i < num_args; i++) {
                     expr * arg  = n->get_arg(i);
                     if (m_context.find_assignment(arg) == l_true) {
-                        if (is_relevant_core(arg))
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
                             return;
+                        }
                         else if (!true_arg)
                             true_arg = arg;
                     }
                 }
-                if (true_arg)
+                if (true_arg) {
                     mark_as_relevant(true_arg);
+                    set_justified(n);
+                }
                 break;
             } }
         }
@@ -397,6 +435,8 @@ namespace smt {
            \brief Propagate relevancy for an and-application.
         */
         void propagate_relevant_and(app * n) {
+            if (is_justified(n))
+                return;
             lbool val    = m_context.find_assignment(n);
             switch (val) {
             case l_false: {
@@ -405,20 +445,25 @@ namespace smt {
                 for (unsigned i = 0; i < num_args; i++) {
                     expr * arg  = n->get_arg(i);
                     if (m_context.find_assignment(arg) == l_false) {
-                        if (is_relevant_core(arg))
+                        if (is_relevant_core(arg)) {
+                            set_justified(n);
                             return; 
+                        }
                         else if (!false_arg)
                             false_arg = arg;
                     }
                 }
-                if (false_arg)
+                if (false_arg) {
                     mark_as_relevant(false_arg);
+                    set_justified(n);
+                }
                 break;
             }
             case l_undef:
                 break;
             case l_true:
                 propagate_relevant_app(n);
+                set_justified(n);
                 break;
             }
         }
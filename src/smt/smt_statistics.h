@@ -46,6 +46,7 @@ namespace smt {
         unsigned m_max_generation;
         unsigned m_num_minimized_lits;
         unsigned m_num_checks;
+        unsigned m_num_cached_cores;
         statistics() {
             reset();
         }
@@ -45,7 +45,7 @@ namespace smt {
         unsigned m_assert_lower, m_assert_upper, m_assert_diseq, m_core2th_eqs, m_core2th_diseqs;
         unsigned m_th2core_eqs, m_th2core_diseqs, m_bound_props, m_offset_eqs, m_fixed_eqs, m_offline_eqs;
         unsigned m_max_min; 
-        unsigned m_gb_simplify, m_gb_superpose, m_gb_compute_basis, m_gb_num_processed;
+        unsigned m_gb_simplify, m_gb_superpose, m_gb_compute_basis, m_gb_num_processed, m_gb_skipped, m_gb_early_conflicts;
         unsigned m_nl_branching, m_nl_linear, m_nl_bounds, m_nl_cross_nested;
 
         void reset() { memset(this, 0, sizeof(theory_arith_stats)); }
@@ -949,6 +949,16 @@ namespace smt {
         bool            m_model_depends_on_computed_epsilon;
         unsigned        m_nl_rounds;
         bool            m_nl_gb_exhausted;
+        // input of a Grobner basis computation: the variables of a cluster with their bounds and rows.
+        struct gb_input {
+            unsigned            m_hash;
+            svector<int>        m_vars;   // per variable: the variable, its kind, and the variables of its row
+            vector<inf_numeral> m_bounds;
+            vector<numeral>     m_coeffs;
+            gb_input(): m_hash(0) {}
+            bool operator==(gb_input const & other) const;
+        };
+        vector<gb_input> m_nl_gb_failed; // inputs on which the Grobner basis made no progress
         unsigned        m_nl_strategy_idx; // for fairness
         expr_ref_vector m_nl_new_exprs;
         typedef obj_map<expr, unsigned> var2num_occs;
@@ -1027,7 +1037,10 @@ namespace smt {
         expr * monomial2expr(grobner::monomial const * m, bool is_int);
         bool internalize_gb_eq(grobner::equation const * eq);
         enum gb_result { GB_PROGRESS, GB_NEW_EQ, GB_FAIL };
+        void mk_gb_input(svector<theory_var> const & nl_cluster, gb_input & in) const;
+        bool gb_failed_on(gb_input const & in) const;
         gb_result compute_grobner(svector<theory_var> const & nl_cluster);
+        gb_result compute_grobner_core(svector<theory_var> const & nl_cluster);
         bool max_min_nl_vars();
         final_check_status process_non_linear();
         
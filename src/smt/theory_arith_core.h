@@ -1599,6 +1599,7 @@ namespace smt {
         m_nl_propagated          .reset();
         m_nl_rounds              = 0;
         m_nl_gb_exhausted        = false;
+        m_nl_gb_failed           .reset();
         m_nl_strategy_idx        = 0;
         theory::reset_eh();
     }
@@ -1703,7 +1704,7 @@ namespace smt {
 
     template<typename Ext>
     theory* theory_arith<Ext>::mk_fresh(context* new_ctx) { 
-        return alloc(theory_arith<Ext>, new_ctx->get_manager(), m_params); 
+        return alloc(theory_arith<Ext>, new_ctx->get_manager(), new_ctx->get_fparams()); 
     }
 
     template<typename Ext>
@@ -2232,13 +2232,100 @@ namespace smt {
         return true;
     }
 
+    template<typename Ext>
+    bool theory_arith<Ext>::gb_input::operator==(gb_input const & other) const {
+        if (m_hash != other.m_hash || m_vars.size() != other.m_vars.size() ||
+            m_bounds.size() != other.m_bounds.size() || m_coeffs.size() != other.m_coeffs.size())
+            return false;
+        for (unsigned i = 0; i < m_vars.size(); ++i)
+            if (m_vars[i] != other.m_vars[i])
+                return false;
+        for (unsigned i = 0; i < m_bounds.size(); ++i)
+            if (m_bounds[i] != other.m_bounds[i])
+                return false;
+        for (unsigned i = 0; i < m_coeffs.size(); ++i)
+            if (m_coeffs[i] != other.m_coeffs[i])
+                return false;
+        return true;
+    }
+
+    /**
+       \brief Collect the input of the Grobner basis computation on the cluster:
+       its variables, their bounds, whether they contribute a monomial definition,
+       and the rows of the base variables with the bounds of their variables.
+    */
+    template<typename Ext>
+    void theory_arith<Ext>::mk_gb_input(svector<theory_var> const & nl_cluster, gb_input & in) const {
+        unsigned h = nl_cluster.size();
+        auto add_var = [&](theory_var v, int kind) {
+            in.m_vars.push_back(v);
+            kind = 4 * kind + (lower(v) ? 2 : 0) + (upper(v) ? 1 : 0);
+            in.m_vars.push_back(kind);
+            h = combine_hash(h, v);
+            h = combine_hash(h, kind);
+            if (lower(v)) {
+                in.m_bounds.push_back(lower_bound(v));
+                h = combine_hash(h, lower_bound(v).hash());
+            }
+            if (upper(v)) {
+                in.m_bounds.push_back(upper_bound(v));
+                h = combine_hash(h, upper_bound(v).hash());
+            }
+        };
+        for (theory_var v : nl_cluster) {
+            bool def = is_pure_monomial(v) && !m_data[v].m_nl_propagated && is_fixed(v);
+            add_var(v, (is_base(v) ? 2 : 0) + (def ? 1 : 0));
+            if (!is_base(v))
+                continue;
+            row const & r = m_rows[get_var_row(v)];
+            for (auto it = r.begin_entries(), end = r.end_entries(); it != end; ++it) {
+                if (it->is_dead())
+                    continue;
+                add_var(it->m_var, 4);
+                in.m_coeffs.push_back(it->m_coeff);
+                h = combine_hash(h, it->m_coeff.hash());
+            }
+        }
+        in.m_hash = h;
+    }
+
+    template<typename Ext>
+    bool theory_arith<Ext>::gb_failed_on(gb_input const & in) const {
+        for (gb_input const & f : m_nl_gb_failed)
+            if (f == in)
+                return true;
+        return false;
+    }
+
     /**
        \brief Compute Grobner basis, return true if a conflict or new fixed variables were detected.
+
+       The computation is skipped if it already made no progress on the same input: the
+       inputs of such computations are kept across final checks and backtracking.
+       The basis is checked for inconsistencies after each step, so the computation stops as soon
+       as a conflicting equation is derived.
     */
     template<typename Ext>
     typename theory_arith<Ext>::gb_result theory_arith<Ext>::compute_grobner(svector<theory_var> const & nl_cluster) {
         if (m_nl_gb_exhausted)
             return GB_FAIL;
+        gb_input in;
+        mk_gb_input(nl_cluster, in);
+        if (gb_failed_on(in)) {
+            m_stats.m_gb_skipped++;
+            return GB_FAIL;
+        }
+        gb_result result = compute_grobner_core(nl_cluster);
+        if (result == GB_FAIL && !get_context().get_cancel_flag()) {
+            if (m_nl_gb_failed.size() > 1024)
+                m_nl_gb_failed.reset();
+            m_nl_gb_failed.push_back(in);
+        }
+        return result;
+    }
+
+    template<typename Ext>
+    typename theory_arith<Ext>::gb_result theory_arith<Ext>::compute_grobner_core(svector<theory_var> const & nl_cluster) {
         grobner gb(get_manager(), m_dep_manager);
         init_grobner(nl_cluster, gb);
         TRACE("non_linear", display(tout););
@@ -2256,6 +2343,15 @@ namespace smt {
                     break;
                 }
                 r = gb.compute_basis_step();
+                grobner::equation const * new_eq = gb.get_last_processed();
+                if (new_eq && is_inconsistent(new_eq, gb)) {
+                    m_stats.m_gb_early_conflicts++;
+                    m_stats.m_gb_simplify      += gb.m_stats.m_simplify;
+                    m_stats.m_gb_superpose     += gb.m_stats.m_superpose;
+                    m_stats.m_gb_num_processed += gb.m_stats.m_num_processed;
+                    m_stats.m_gb_compute_basis++;
+                    return GB_PROGRESS;
+                }
             }
             m_stats.m_gb_simplify      += gb.m_stats.m_simplify;
             m_stats.m_gb_superpose     += gb.m_stats.m_superpose;
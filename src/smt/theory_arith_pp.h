@@ -40,6 +40,8 @@ namespace smt {
         st.update("arith gomory cuts", m_stats.m_gomory_cuts);
         st.update("arith max-min", m_stats.m_max_min);
         st.update("arith grobner", m_stats.m_gb_compute_basis);
+        st.update("arith grobner skipped", m_stats.m_gb_skipped);
+        st.update("arith grobner early conflicts", m_stats.m_gb_early_conflicts);
         st.update("arith pseudo nonlinear", m_stats.m_nl_linear);
         st.update("arith nonlinear bounds", m_stats.m_nl_bounds);
         st.update("arith nonlinear horner", m_stats.m_nl_cross_nested);
@@ -860,6 +860,10 @@ namespace smt {
         if (approximate_term(term)) {
             return false;
         }
+        if (m_params.m_bv_lazy_blast && is_lazy_op(term)) {
+            internalize_lazy_op(term);
+            return true;
+        }
         switch (term->get_decl_kind()) {
         case OP_BV_NUM:         internalize_num(term); return true;
         case OP_BADD:           internalize_add(term); return true;
@@ -1331,8 +1335,167 @@ namespace smt {
         theory::pop_scope_eh(num_scopes);
     }
 
+    bool theory_bv::is_lazy_op(app * n) const {
+        switch (n->get_decl_kind()) {
+        case OP_BMUL:
+        case OP_BUDIV_I:
+        case OP_BSDIV_I:
+        case OP_BUREM_I:
+        case OP_BSREM_I:
+        case OP_BSMOD_I:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+       \brief Create fresh bits for n. The circuit for n is added by blast_lazy_op
+       if final check finds the value of n inconsistent with its arguments too often.
+    */
+    void theory_bv::internalize_lazy_op(app * n) {
+        SASSERT(!get_context().e_internalized(n));
+        process_args(n);
+        enode * e    = mk_enode(n);
+        theory_var v = e->get_th_var(get_id());
+        mk_bits(v);
+        find_wpos(v);
+        m_lazy_ops.push_back(lazy_op(n));
+        m_trail_stack.push(push_back_vector<theory_bv, svector<lazy_op> >(m_lazy_ops));
+    }
+
+    class lazy_blast_trail : public trail<theory_bv> {
+        unsigned m_idx;
+    public:
+        lazy_blast_trail(unsigned idx): m_idx(idx) {}
+        void undo(theory_bv & th) override {
+            th.m_lazy_ops[m_idx].m_blasted = false;
+        }
+    };
+
+    void theory_bv::blast_lazy_op(unsigned idx) {
+        context & ctx   = get_context();
+        ast_manager & m = get_manager();
+        app * n         = m_lazy_ops[idx].m_term;
+        enode * e       = ctx.get_enode(n);
+        theory_var v    = e->get_th_var(get_id());
+        expr_ref_vector arg1_bits(m), arg2_bits(m), bits(m);
+        unsigned i = n->get_num_args() - 1;
+        get_arg_bits(e, i, bits);
+        while (i > 0) {
+            --i;
+            arg1_bits.reset();
+            arg2_bits.reset();
+            get_arg_bits(e, i, arg1_bits);
+            unsigned sz = arg1_bits.size();
+            switch (n->get_decl_kind()) {
+            case OP_BMUL:    m_bb.mk_multiplier(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            case OP_BUDIV_I: m_bb.mk_udiv(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            case OP_BSDIV_I: m_bb.mk_sdiv(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            case OP_BUREM_I: m_bb.mk_urem(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            case OP_BSREM_I: m_bb.mk_srem(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            case OP_BSMOD_I: m_bb.mk_smod(sz, arg1_bits.c_ptr(), bits.c_ptr(), arg2_bits); break;
+            default: UNREACHABLE(); break;
+            }
+            bits.swap(arg2_bits);
+        }
+        literal_vector const & v_bits = m_bits[v];
+        SASSERT(bits.size() == v_bits.size());
+        for (unsigned k = 0; k < bits.size(); ++k) {
+            expr_ref s_bit(m);
+            simplify_bit(bits.get(k), s_bit);
+            ctx.internalize(s_bit, true);
+            literal l = ctx.get_literal(s_bit);
+            ctx.mark_as_relevant(l);
+            ctx.mk_th_axiom(get_id(), ~l, v_bits[k]);
+            ctx.mk_th_axiom(get_id(), l, ~v_bits[k]);
+        }
+        m_lazy_ops[idx].m_blasted = true;
+        m_trail_stack.push(lazy_blast_trail(idx));
+        m_stats.m_num_lazy_blasted++;
+        TRACE("bv", tout << "blasted " << mk_bounded_pp(n, m) << "\n";);
+    }
+
+    /**
+       \brief Assert that the arguments of a lazy operator, with their current values,
+       determine its value val: (/\_j arg_j = val_j) => bit_k(n) = bit_k(val).
+    */
+    void theory_bv::mk_value_lemma(unsigned idx, numeral const & val) {
+        context & ctx = get_context();
+        app * n       = m_lazy_ops[idx].m_term;
+        enode * e     = ctx.get_enode(n);
+        theory_var v  = e->get_th_var(get_id());
+        literal_vector lits;
+        for (unsigned i = 0; i < n->get_num_args(); ++i) {
+            for (literal l : m_bits[get_arg_var(e, i)]) {
+                lits.push_back(ctx.get_assignment(l) == l_true ? ~l : l);
+            }
+        }
+        literal_vector const & v_bits = m_bits[v];
+        for (unsigned k = 0; k < v_bits.size(); ++k) {
+            bool is_one = !(div(val, m_bb.power(k)) % rational(2)).is_zero();
+            lits.push_back(is_one ? v_bits[k] : ~v_bits[k]);
+            justification * js = nullptr;
+            if (get_manager().proofs_enabled()) {
+                js = alloc(theory_lemma_justification, get_id(), ctx, lits.size(), lits.c_ptr());
+            }
+            ctx.mk_clause(lits.size(), lits.c_ptr(), js, CLS_AUX_LEMMA, nullptr);
+            lits.pop_back();
+        }
+        m_lazy_ops[idx].m_num_refinements++;
+        m_stats.m_num_lazy_refinements++;
+    }
+
+    /**
+       \brief Check the values of the lazy operators against the values of their arguments.
+       Return false if a value lemma was added or an operator was bit-blasted.
+    */
+    bool theory_bv::check_lazy_ops() {
+        context & ctx   = get_context();
+        ast_manager & m = get_manager();
+        bool ok = true;
+        for (unsigned idx = 0; idx < m_lazy_ops.size(); ++idx) {
+            lazy_op const & op = m_lazy_ops[idx];
+            if (op.m_blasted || !ctx.is_relevant(op.m_term)) {
+                continue;
+            }
+            app * n      = op.m_term;
+            enode * e    = ctx.get_enode(n);
+            theory_var v = e->get_th_var(get_id());
+            unsigned sz  = get_bv_size(n);
+            expr_ref_vector args(m);
+            numeral val;
+            bool fixed = true;
+            for (unsigned i = 0; fixed && i < n->get_num_args(); ++i) {
+                fixed = get_fixed_value(get_arg_var(e, i), val);
+                args.push_back(m_util.mk_numeral(val, sz));
+            }
+            numeral curr;
+            if (!fixed || !get_fixed_value(v, curr) || op.m_num_refinements >= m_params.m_bv_lazy_blast_max_refinements) {
+                blast_lazy_op(idx);
+                ok = false;
+                continue;
+            }
+            expr_ref r(m.mk_app(n->get_decl(), args.size(), args.c_ptr()), m);
+            ctx.get_rewriter()(r);
+            if (!m_util.is_numeral(r, val, sz)) {
+                blast_lazy_op(idx);
+                ok = false;
+            }
+            else if (val != curr) {
+                TRACE("bv", tout << mk_bounded_pp(n, m) << " := " << curr << " expected " << val << "\n";);
+                mk_value_lemma(idx, val);
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
     final_check_status theory_bv::final_check_eh() {
         SASSERT(check_invariant());
+        if (m_params.m_bv_lazy_blast && !check_lazy_ops()) {
+            return FC_CONTINUE;
+        }
         if (m_approximates_large_bvs) {
             return FC_GIVEUP;
         }
@@ -1665,6 +1828,8 @@ namespace smt {
         st.update("bv bit2core", m_stats.m_num_bit2core);
         st.update("bv->core eq", m_stats.m_num_th2core_eq);
         st.update("bv dynamic eqs", m_stats.m_num_eq_dynamic);
+        st.update("bv lazy blasted ops", m_stats.m_num_lazy_blasted);
+        st.update("bv lazy refinements", m_stats.m_num_lazy_refinements);
     }
 
 #ifdef Z3DEBUG
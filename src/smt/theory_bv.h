@@ -32,6 +32,7 @@ namespace smt {
     struct theory_bv_stats {
         unsigned   m_num_diseq_static, m_num_diseq_dynamic, m_num_bit2core, m_num_th2core_eq, m_num_conflicts;
         unsigned   m_num_eq_dynamic;
+        unsigned   m_num_lazy_blasted, m_num_lazy_refinements;
         void reset() { memset(this, 0, sizeof(theory_bv_stats)); }
         theory_bv_stats() { reset(); }
     };
@@ -128,6 +129,15 @@ namespace smt {
         svector<var_pos>         m_prop_queue;
         bool                     m_approximates_large_bvs;
 
+        // multipliers and dividers whose bit-blasting is delayed (m_bv_lazy_blast).
+        struct lazy_op {
+            app *    m_term;
+            unsigned m_num_refinements;
+            bool     m_blasted;
+            lazy_op(app * n): m_term(n), m_num_refinements(0), m_blasted(false) {}
+        };
+        svector<lazy_op>         m_lazy_ops;
+
         theory_var find(theory_var v) const { return m_find.find(v); }
         theory_var next(theory_var v) const { return m_find.next(v); }
         bool is_root(theory_var v) const { return m_find.is_root(v); }
@@ -214,6 +224,12 @@ namespace smt {
         void assign_bit(literal consequent, theory_var v1, theory_var v2, unsigned idx, literal antecedent, bool propagate_eqc);
         void assert_int2bv_axiom(app* n);
         void assert_bv2int_axiom(app* n);
+        bool is_lazy_op(app * n) const;
+        void internalize_lazy_op(app * n);
+        void blast_lazy_op(unsigned idx);
+        void mk_value_lemma(unsigned idx, numeral const & val);
+        bool check_lazy_ops();
+        friend class lazy_blast_trail;
 
     protected:
         void init(context * ctx) override;
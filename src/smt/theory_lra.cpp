@@ -24,6 +24,7 @@ Revision History:
 #include "util/lp/lp_dual_simplex.h"
 #include "util/lp/indexed_value.h"
 #include "util/lp/lar_solver.h"
+#include "util/lp/int_solver.h"
 #include "util/nat_set.h"
 #include "util/optional.h"
 #include "util/lp/lp_params.hpp"
@@ -90,6 +91,7 @@ namespace lra_lp {
         unsigned m_num_iterations_with_no_progress;
         unsigned m_num_factorizations;
         unsigned m_need_to_solve_inf;
+        unsigned m_bound_propagation_rows;
         unsigned m_fixed_eqs;
         unsigned m_conflicts;
         unsigned m_bound_propagations1;
@@ -98,6 +100,9 @@ namespace lra_lp {
         unsigned m_make_feasible;
         unsigned m_max_cols;
         unsigned m_max_rows;
+        unsigned m_branches;
+        unsigned m_gomory_cuts;
+        unsigned m_gcd_conflicts;
         stats() { reset(); }
         void reset() {
             memset(this, 0, sizeof(*this));
@@ -267,6 +272,7 @@ namespace smt {
         lra_lp::stats              m_stats;
         arith_factory*         m_factory;
         scoped_ptr<lp::lar_solver> m_solver;
+        scoped_ptr<lp::int_solver> m_int_solver;
         resource_limit         m_resource_limit;
         lp_bounds              m_new_bounds;
 
@@ -286,9 +292,13 @@ namespace smt {
             m_theory_var2var_index.reset();
             m_solver->settings().set_resource_limit(m_resource_limit);
             m_solver->settings().simplex_strategy() = static_cast<lp::simplex_strategy_enum>(lp.simplex_strategy());
+            m_solver->settings().presolve_with_double_solver_for_lar = lp.presolve_with_doubles();
             reset_variable_values();
             m_solver->settings().bound_propagation() = BP_NONE != propagation_mode();
             m_solver->set_propagate_bounds_on_pivoted_rows_mode(lp.bprop_on_pivoted_rows());
+            m_solver->settings().bound_propagation_budget = lp.bprop_budget();
+            m_solver->settings().m_int_branch_cut_ratio = m_arith_params.m_arith_branch_cut_ratio;
+            m_int_solver = alloc(lp::int_solver, *m_solver);
             //m_solver->settings().set_ostream(0);
         }
 
@@ -380,6 +390,12 @@ namespace smt {
                     if (a.is_div(n, n1, n2) && is_numeral(n2, r)) {
                         // skip
                     }
+                    else if ((a.is_idiv(n, n1, n2) || a.is_mod(n, n1, n2) || a.is_rem(n, n1, n2)) && is_numeral(n2, r) && !r.is_zero()) {
+                        // skip, axiomatized in relevant_eh
+                    }
+                    else if (a.is_to_int(n)) {
+                        // skip, axiomatized in relevant_eh
+                    }
                     else {
                         found_not_handled(n);
                     }
@@ -394,9 +410,6 @@ namespace smt {
                     if (is_app(n)) {
                         internalize_args(to_app(n));
                     }
-                    if (a.is_int(n)) {
-                        found_not_handled(n);
-                    }
                     theory_var v = mk_var(n);
                     coeffs[vars.size()] = coeffs[index];
                     vars.push_back(v);
@@ -493,7 +506,7 @@ namespace smt {
                 result = m_theory_var2var_index[v];
             }
             if (result == UINT_MAX) {
-                result = m_solver->add_var(v); // TBD: is_int(v);
+                result = m_solver->add_var(v, is_int(v));
                 m_theory_var2var_index.setx(v, result, UINT_MAX);
                 m_var_index2theory_var.setx(result, v, UINT_MAX);
                 m_var_trail.push_back(v);
@@ -1086,7 +1099,9 @@ namespace smt {
                   }
                   tout << "\n";
                   );
-            m_solver->random_update(vars.size(), vars.c_ptr());
+            // moving the values of non-basic columns can break integrality.
+            if (!m_solver->has_int_var())
+                m_solver->random_update(vars.size(), vars.c_ptr());
             m_model_eqs.reset();
             TRACE("arith", display(tout););
 
@@ -1174,6 +1189,14 @@ namespace smt {
             }
             switch (is_sat) {
             case l_true:
+                switch (check_lia()) {
+                case l_true:
+                    break;
+                case l_false:
+                    return FC_CONTINUE;
+                case l_undef:
+                    return FC_GIVEUP;
+                }
                 if (delayed_assume_eqs()) {
                     return FC_CONTINUE;
                 }
@@ -1968,12 +1991,23 @@ namespace smt {
             else {
                 ++m_stats.m_assert_upper;
             }
+            rational bound = b.get_value();
+            if (is_int(b.get_var())) {
+                // strengthen the bound to an integral non-strict one.
+                switch (k) {
+                case lp::LT: k = lp::LE; bound = ceil(bound) - rational::one(); break;
+                case lp::LE: bound = floor(bound); break;
+                case lp::GT: k = lp::GE; bound = floor(bound) + rational::one(); break;
+                case lp::GE: bound = ceil(bound); break;
+                default: break;
+                }
+            }
             auto vi = get_var_index(b.get_var());
-            auto ci = m_solver->add_var_bound(vi, k, b.get_value());
+            auto ci = m_solver->add_var_bound(vi, k, bound);
             TRACE("arith", tout << "v" << b.get_var() << "\n";);
             add_ineq_constraint(ci, literal(bv, !is_true));
 
-            propagate_eqs(vi, ci, k, b);
+            propagate_eqs(vi, ci, k, b, bound);
         }
 
         //
@@ -1991,9 +2025,8 @@ namespace smt {
         typedef map<value_sort_pair, theory_var, value_sort_pair_hash, default_eq<value_sort_pair> > value2var;
         value2var               m_fixed_var_table;
 
-        void propagate_eqs(lp::var_index vi, lp::constraint_index ci, lp::lconstraint_kind k, lra_lp::bound& b) {
+        void propagate_eqs(lp::var_index vi, lp::constraint_index ci, lp::lconstraint_kind k, lra_lp::bound& b, rational const& value) {
             if (propagate_eqs()) {
-                rational const& value = b.get_value();
                 if (k == lp::GE) {
                     set_lower_bound(vi, ci, value);
                     if (has_upper_bound(vi, ci, value)) {
@@ -2152,6 +2185,7 @@ namespace smt {
             m_stats.m_num_iterations = m_solver->settings().st().m_total_iterations;
             m_stats.m_num_factorizations = m_solver->settings().st().m_num_factorizations;
             m_stats.m_need_to_solve_inf = m_solver->settings().st().m_need_to_solve_inf;
+            m_stats.m_bound_propagation_rows = m_solver->settings().st().m_num_of_rows_for_bound_propagation;
 
             switch (status) {
             case lp::lp_status::INFEASIBLE:
@@ -2205,9 +2239,6 @@ namespace smt {
         }
 
         void set_conflict() {
-            m_eqs.reset();
-            m_core.reset();
-            m_params.reset();
             m_explanation.clear();
             m_solver->get_infeasibility_explanation(m_explanation);
             // m_solver->shrink_explanation_to_minimum(m_explanation); // todo, enable when perf is fixed
@@ -2217,6 +2248,13 @@ namespace smt {
             num_l+=m_explanation.size();
             std::cout << num_l / (++cn) << "\n";
             */
+            set_conflict_from_explanation();
+        }
+
+        void set_conflict_from_explanation() {
+            m_eqs.reset();
+            m_core.reset();
+            m_params.reset();
             ++m_num_conflicts;
             ++m_stats.m_conflicts;
             TRACE("arith", tout << "scope: " << ctx().get_scope_level() << "\n"; display_evidence(tout, m_explanation); );
@@ -2235,12 +2273,130 @@ namespace smt {
                         m_eqs.size(), m_eqs.c_ptr(), m_params.size(), m_params.c_ptr())));
         }
 
+        /**
+           \brief Return the theory variable of column j and the constant that
+           is dropped when a term is turned into a column: the value of the
+           theory variable is the value of the column plus offset.
+        */
+        theory_var column2theory_var(unsigned j, rational& offset) const {
+            offset.reset();
+            unsigned vi = m_solver->adjust_column_index_to_term_index(j);
+            if (m_solver->is_term(vi)) {
+                offset = m_solver->get_term(vi).m_v;
+                return m_term_index2theory_var.get(m_solver->adjust_term_index(vi), null_theory_var);
+            }
+            return m_var_index2theory_var.get(vi, null_theory_var);
+        }
+
+        /**
+           \brief Create the atom  sum of coeff * column >= k  over the theory variables.
+           The atom is over the integers if all columns are integral and the
+           coefficients are integers. Mixed atoms are not created, since to_real
+           is not handled by the linearizer.
+        */
+        expr_ref mk_ge(lp::lar_term const& t, rational const& k) {
+            rational rhs(k), offset;
+            bool all_int = k.is_int();
+            ptr_vector<expr> owners;
+            vector<rational> coeffs;
+            for (auto const& p : t.m_coeffs) {
+                theory_var v = column2theory_var(p.first, offset);
+                if (v == null_theory_var) {
+                    return expr_ref(m);
+                }
+                rhs += p.second * offset;
+                all_int &= p.second.is_int() && is_int(v);
+                owners.push_back(get_owner(v));
+                coeffs.push_back(p.second);
+            }
+            all_int &= rhs.is_int();
+            expr_ref_vector args(m);
+            for (unsigned i = 0; i < owners.size(); ++i) {
+                expr* e = owners[i];
+                if (!all_int && a.is_int(e)) {
+                    return expr_ref(m);
+                }
+                args.push_back(coeffs[i].is_one() ? e : a.mk_mul(a.mk_numeral(coeffs[i], all_int), e));
+            }
+            expr_ref sum(args.size() == 1 ? args.get(0) : a.mk_add(args.size(), args.c_ptr()), m);
+            return expr_ref(a.mk_ge(sum, a.mk_numeral(rhs, all_int)), m);
+        }
+
+        /**
+           \brief Integer feasibility of the current solution of the LP relaxation.
+           Return l_true if all integer variables have integral values, l_false if
+           a branch, a cut or a conflict was produced, and l_undef if the integer
+           solver gives up.
+        */
+        // term <= k or term >= k + 1
+        lbool branch(lp::lar_term const& term, rational const& k) {
+            expr_ref ge = mk_ge(term, k + rational::one());
+            if (!ge) {
+                return l_undef;
+            }
+            ++m_stats.m_branches;
+            literal lit = mk_literal(ge);
+            TRACE("arith", tout << "branch: " << ge << "\n";);
+            ctx().mark_as_relevant(lit);
+            return l_false;
+        }
+
+        lbool check_lia() {
+            if (m.canceled()) {
+                return l_undef;
+            }
+            lp::lar_term term;
+            rational k;
+            m_explanation.clear();
+            switch (m_int_solver->check(term, k, m_explanation)) {
+            case lp::lia_move::ok:
+                return l_true;
+            case lp::lia_move::branch:
+                return branch(term, k);
+            case lp::lia_move::cut: {
+                expr_ref ge = mk_ge(term, k);
+                if (!ge) {
+                    if (m_int_solver->branch(term, k) != lp::lia_move::branch) {
+                        return l_undef;
+                    }
+                    return branch(term, k);
+                }
+                ++m_stats.m_gomory_cuts;
+                m_eqs.reset();
+                m_core.reset();
+                for (auto const& ev : m_explanation) {
+                    set_evidence(ev.second);
+                }
+                literal_vector lits;
+                for (literal l : m_core) {
+                    lits.push_back(~l);
+                }
+                for (enode_pair const& p : m_eqs) {
+                    lits.push_back(~th.mk_eq(p.first->get_owner(), p.second->get_owner(), false));
+                }
+                literal lit = mk_literal(ge);
+                lits.push_back(lit);
+                TRACE("arith", tout << "cut: " << ge << "\n";);
+                ctx().mk_th_axiom(get_id(), lits.size(), lits.c_ptr());
+                ctx().mark_as_relevant(lit);
+                return l_false;
+            }
+            case lp::lia_move::conflict:
+                ++m_stats.m_gcd_conflicts;
+                set_conflict_from_explanation();
+                return l_false;
+            default:
+                return l_undef;
+            }
+        }
+
         justification * why_is_diseq(theory_var v1, theory_var v2) {
             return nullptr;
         }
 
         void reset_eh() {
             m_arith_eq_adapter.reset_eh();
+            m_int_solver = nullptr;
             m_solver = nullptr;
             m_not_handled = nullptr;
             del_bounds(0);
@@ -2516,10 +2672,14 @@ namespace smt {
             st.update("arith-conflicts", m_stats.m_conflicts);
             st.update("arith-bound-propagations-lp", m_stats.m_bound_propagations1);
             st.update("arith-bound-propagations-cheap", m_stats.m_bound_propagations2);
+            st.update("arith-bound-propagation-rows", m_stats.m_bound_propagation_rows);
             st.update("arith-diseq", m_stats.m_assert_diseq);
             st.update("arith-make-feasible", m_stats.m_make_feasible);
             st.update("arith-max-columns", m_stats.m_max_cols);
             st.update("arith-max-rows", m_stats.m_max_rows);
+            st.update("arith-branch", m_stats.m_branches);
+            st.update("arith-gomory-cuts", m_stats.m_gomory_cuts);
+            st.update("arith-gcd-conflicts", m_stats.m_gcd_conflicts);
         }
     };
 
@@ -2611,6 +2611,7 @@ void theory_seq::collect_statistics(::statistics & st) const {
     st.update("seq extensionality", m_stats.m_extensionality);
     st.update("seq fixed length", m_stats.m_fixed_length);
     st.update("seq int.to.str", m_stats.m_int_string);
+    st.update("seq re derivatives", m_stats.m_re_derivatives);
 }
 
 void theory_seq::init_search_eh() {
@@ -3412,8 +3413,19 @@ void theory_seq::propagate_in_re(expr* n, bool is_true) {
         return;
     }
 
-    expr_ref e3(re, m);
     context& ctx = get_context();
+    expr_ref rest(m), d(m);
+    if (derive_in_re(s, re, rest, d)) {
+        // s = c_1 ... c_k rest: s in re <=> rest in D_{c_1...c_k}(re)
+        literal lit = ctx.get_literal(n);
+        literal dlit = mk_literal(m_util.re.mk_in_re(rest, d));
+        m_stats.m_re_derivatives++;
+        add_axiom(~lit, dlit);
+        add_axiom(lit, ~dlit);
+        return;
+    }
+
+    expr_ref e3(re, m);
     literal lit = ctx.get_literal(n);
     if (!is_true) {
         e3 = m_util.re.mk_complement(re);
@@ -3450,6 +3462,37 @@ void theory_seq::propagate_in_re(expr* n, bool is_true) {
 }
 
 
+/**
+   \brief Consume the constant prefix of s by taking derivatives of re.
+   The automaton is then only built for the residual of re, which covers
+   the states that are reachable after the prefix.
+*/
+bool theory_seq::derive_in_re(expr* s, expr* re, expr_ref& rest, expr_ref& d) {
+    expr_ref_vector es(m);
+    m_util.str.get_concat(s, es);
+    zstring str;
+    unsigned i = 0;
+    d = re;
+    for (; i < es.size() && m_util.str.is_string(es.get(i), str); ++i) {
+        for (unsigned j = 0; j < str.length(); ++j) {
+            if (!m_seq_rewrite.mk_re_derivative(str[j], d, d)) {
+                return false;
+            }
+        }
+    }
+    if (i == 0) {
+        return false;
+    }
+    if (i == es.size()) {
+        rest = m_util.str.mk_empty(m.get_sort(s));
+    }
+    else {
+        rest = m_util.str.mk_concat(es.size() - i, es.c_ptr() + i);
+    }
+    TRACE("seq", tout << mk_pp(s, m) << " in " << mk_pp(re, m) << " => " << rest << " in " << d << "\n";);
+    return true;
+}
+
 expr_ref theory_seq::mk_sub(expr* a, expr* b) {
     expr_ref result(m_autil.mk_sub(a, b), m);
     m_rewrite(result);
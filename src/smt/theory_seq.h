@@ -288,6 +288,7 @@ namespace smt {
             unsigned m_fixed_length;
             unsigned m_propagate_contains;
             unsigned m_int_string;
+            unsigned m_re_derivatives;
         };
         typedef hashtable<rational, rational::hash_proc, rational::eq_proc> rational_set;
 
@@ -540,6 +541,7 @@ namespace smt {
 
         // automata utilities
         void propagate_in_re(expr* n, bool is_true);
+        bool derive_in_re(expr* s, expr* re, expr_ref& rest, expr_ref& d);
         eautomaton* get_automaton(expr* e);
         literal mk_accept(expr* s, expr* idx, expr* re, expr* state);
         literal mk_accept(expr* s, expr* idx, expr* re, unsigned i) { return mk_accept(s, idx, re, m_autil.mk_int(i)); }
@@ -63,6 +63,10 @@ namespace smt {
         avoidLoopCut(true),
         loopDetected(false),
         m_theoryStrOverlapAssumption_term(m),
+        m_arrangement_trail(m),
+        m_arrangement_rec(nullptr),
+        m_length_hint_vars(m),
+        m_length_presolve_num_formulas(UINT_MAX),
         contains_map(m),
         string_int_conversion_terms(m),
         totalCacheAccessCount(0),
@@ -119,6 +123,194 @@ namespace smt {
         }
     };
 
+    /*
+     * Abstraction of string constraints to constraints over the lengths of string terms.
+     * String terms are replaced by integer terms for their lengths, and string predicates
+     * by fresh Boolean constants that imply the length constraints they entail.
+     * The abstraction is an over-approximation: if it is unsatisfiable, so are the string constraints.
+     */
+    class str_length_abstraction {
+        ast_manager &       m;
+        seq_util            u;
+        arith_util          a;
+        expr_ref_vector     m_pinned;
+        obj_map<expr, expr*> m_len_cache;
+        obj_map<expr, expr*> m_abs_cache;
+        expr_ref_vector     m_side;
+        obj_map<expr, expr*> m_vars;        // string variable -> its length
+        unsigned            m_num_atoms;     // number of string predicates and length terms
+        bool                m_failed;
+
+        expr * mk_fresh_len(expr * lo, expr * hi) {
+            expr * v = m.mk_fresh_const("len", a.mk_int());
+            m_pinned.push_back(v);
+            m_side.push_back(a.mk_ge(v, lo));
+            if (hi)
+                m_side.push_back(a.mk_le(v, hi));
+            return v;
+        }
+
+        expr * mk_fresh(sort * s) {
+            expr * v = m.mk_fresh_const("str_abs", s);
+            m_pinned.push_back(v);
+            return v;
+        }
+
+        expr * mk_int(unsigned n) {
+            return a.mk_numeral(rational(n), true);
+        }
+
+        expr * len(expr * s) {
+            expr * r = nullptr;
+            if (m_len_cache.find(s, r))
+                return r;
+            zstring str;
+            expr * s1, * s2, * c;
+            if (u.str.is_empty(s)) {
+                r = mk_int(0);
+            } else if (u.str.is_string(s, str)) {
+                r = mk_int(str.length());
+            } else if (u.str.is_concat(s, s1, s2)) {
+                r = a.mk_add(len(s1), len(s2));
+            } else if (m.is_ite(s, c, s1, s2)) {
+                r = m.mk_ite(abstract(c), len(s1), len(s2));
+            } else if (u.str.is_unit(s)) {
+                r = mk_int(1);
+            } else if (u.str.is_at(s, s1, s2)) {
+                r = mk_fresh_len(mk_int(0), mk_int(1));
+            } else if (u.str.is_extract(s)) {
+                r = mk_fresh_len(mk_int(0), len(to_app(s)->get_arg(0)));
+            } else if (is_app(s) && to_app(s)->get_num_args() == 0 && to_app(s)->get_family_id() == null_family_id) {
+                r = mk_fresh_len(mk_int(0), nullptr);
+                m_vars.insert(s, r);
+            } else {
+                // replace, itos, uninterpreted functions
+                r = mk_fresh_len(mk_int(0), nullptr);
+            }
+            m_pinned.push_back(r);
+            m_len_cache.insert(s, r);
+            return r;
+        }
+
+        bool has_string_arg(app * n) const {
+            for (expr * arg : *n) {
+                if (u.is_seq(arg) || u.is_re(arg))
+                    return true;
+            }
+            return false;
+        }
+
+        expr * abstract(expr * e) {
+            expr * r = nullptr;
+            if (m_abs_cache.find(e, r))
+                return r;
+            if (!is_app(e)) {
+                m_failed = true;
+                return e;
+            }
+            app * n = to_app(e);
+            expr * s1, * s2, * s3;
+            if (u.str.is_length(e, s1)) {
+                m_num_atoms++;
+                r = len(s1);
+            } else if (m.is_eq(e, s1, s2) && u.is_seq(s1)) {
+                m_num_atoms++;
+                r = mk_fresh(m.mk_bool_sort());
+                m_side.push_back(m.mk_implies(r, m.mk_eq(len(s1), len(s2))));
+            } else if (u.str.is_prefix(e, s1, s2) || u.str.is_suffix(e, s1, s2) || u.str.is_contains(e, s2, s1)) {
+                // s1 is a prefix, suffix or factor of s2
+                m_num_atoms++;
+                r = mk_fresh(m.mk_bool_sort());
+                m_side.push_back(m.mk_implies(r, a.mk_le(len(s1), len(s2))));
+            } else if (u.str.is_index(e, s1, s2) || u.str.is_index(e, s1, s2, s3)) {
+                m_num_atoms++;
+                r = mk_fresh_len(a.mk_numeral(rational::minus_one(), true), len(s1));
+            } else if (u.str.is_stoi(e, s1)) {
+                m_num_atoms++;
+                r = mk_fresh_len(a.mk_numeral(rational::minus_one(), true), nullptr);
+            } else if (has_string_arg(n)) {
+                r = mk_fresh(m.get_sort(e));
+            } else if (n->get_num_args() == 0) {
+                r = e;
+            } else {
+                ptr_buffer<expr> args;
+                for (expr * arg : *n)
+                    args.push_back(abstract(arg));
+                r = m.mk_app(n->get_decl(), args.size(), args.c_ptr());
+            }
+            m_pinned.push_back(r);
+            m_abs_cache.insert(e, r);
+            return r;
+        }
+
+    public:
+        str_length_abstraction(ast_manager & m):
+            m(m), u(m), a(m), m_pinned(m), m_side(m), m_num_atoms(0), m_failed(false) {}
+
+        void add(expr * e, expr_ref_vector & result) {
+            result.push_back(abstract(e));
+        }
+
+        void get_side_constraints(expr_ref_vector & result) const {
+            result.append(m_side);
+        }
+
+        obj_map<expr, expr*> const & get_vars() const { return m_vars; }
+
+        unsigned get_num_atoms() const { return m_num_atoms; }
+
+        bool failed() const { return m_failed; }
+    };
+
+    void theory_str::length_presolve() {
+        context & ctx = get_context();
+        ast_manager & m = get_manager();
+
+        m_length_hints.reset();
+        m_length_hint_vars.reset();
+
+        str_length_abstraction abs(m);
+        expr_ref_vector fmls(m);
+        unsigned nFormulas = ctx.get_num_asserted_formulas();
+        for (unsigned i = 0; i < nFormulas; ++i) {
+            abs.add(ctx.get_asserted_formula(i), fmls);
+        }
+        if (abs.failed() || abs.get_num_atoms() == 0) {
+            return;
+        }
+        abs.get_side_constraints(fmls);
+
+        smt_params fp(ctx.get_fparams());
+        fp.m_max_conflicts = m_params.m_LengthPresolveMaxConflicts;
+        fp.m_threads = 1;
+        fp.m_profile = false;
+        kernel k(m, fp);
+        for (expr * f : fmls) {
+            k.assert_expr(f);
+        }
+        lbool r = k.check();
+        TRACE("str", tout << "length abstraction: " << r << std::endl;);
+        if (r == l_false) {
+            m_stats.m_num_length_presolve_unsat++;
+            assert_axiom(m.mk_false());
+        } else if (r == l_true) {
+            model_ref mdl;
+            k.get_model(mdl);
+            if (!mdl) {
+                return;
+            }
+            for (auto const & kv : abs.get_vars()) {
+                expr_ref val(m);
+                rational n;
+                if (mdl->eval(kv.m_value, val, true) && m_autil.is_numeral(val, n) && n.is_pos()) {
+                    m_length_hint_vars.push_back(kv.m_key);
+                    m_length_hints.insert(kv.m_key, n);
+                    m_stats.m_num_length_hints++;
+                }
+            }
+        }
+    }
+
     void theory_str::init(context * ctx) {
         theory::init(ctx);
         m_mk_aut.set_solver(alloc(seq_expr_solver, get_manager(),
@@ -220,7 +412,10 @@ namespace smt {
         ctx.mk_th_axiom(get_id(), 1, &lit);
 
         // crash/error avoidance: add all axioms to the trail
-        m_trail.push_back(e);
+        if (!m_trail_axioms.contains(e)) {
+            m_trail_axioms.insert(e);
+            m_trail.push_back(e);
+        }
 
         //TRACE("str", tout << "done asserting " << mk_ismt2_pp(e, get_manager()) << std::endl;);
 
@@ -330,6 +525,17 @@ namespace smt {
     }
 
     bool theory_str::has_self_cut(expr * n1, expr * n2) {
+        bool r = has_self_cut_core(n1, n2);
+        if (m_arrangement_rec) {
+            if (r) 
+                m_arrangement_rec->m_self_cut = true;
+            else 
+                m_arrangement_rec->m_self_cut_checks.push_back(std::make_pair(n1, n2));
+        }
+        return r;
+    }
+
+    bool theory_str::has_self_cut_core(expr * n1, expr * n2) {
         if (!cut_var_map.contains(n1)) {
             return false;
         }
@@ -388,6 +594,9 @@ namespace smt {
     }
 
     void theory_str::add_cut_info_merge(expr * destNode, int slevel, expr * srcNode) {
+        if (m_arrangement_rec) {
+            m_arrangement_rec->m_cut_merges.push_back(std::make_pair(destNode, srcNode));
+        }
         // crash avoidance?
         m_trail.push_back(destNode);
         m_trail.push_back(srcNode);
@@ -583,6 +792,9 @@ namespace smt {
     void theory_str::add_nonempty_constraint(expr * s) {
         context & ctx = get_context();
         ast_manager & m = get_manager();
+        if (m_arrangement_rec) {
+            m_arrangement_rec->m_nonempty_vars.push_back(s);
+        }
 
         expr_ref ax1(mk_not(m, ctx.mk_eq_atom(s, mk_string(""))), m);
         assert_axiom(ax1);
@@ -620,6 +832,9 @@ namespace smt {
         SASSERT(ctx.get_enode(a) != NULL);
         // this might help??
         mk_var(ctx.get_enode(a));
+        if (m_arrangement_rec) {
+            m_arrangement_rec->m_nonempty_vars.push_back(a);
+        }
 
         // assert a variation of the basic string axioms that ensures this string is nonempty
         {
@@ -1990,6 +2205,7 @@ namespace smt {
         m_basicstr_axiom_todo.reset();
         m_str_eq_todo.reset();
         m_concat_axiom_todo.reset();
+        reset_arrangements();
         pop_scope_eh(get_context().get_scope_level());
     }
 
@@ -2669,6 +2885,11 @@ namespace smt {
 
     void theory_str::add_theory_aware_branching_info(expr * term, double priority, lbool phase) {
         context & ctx = get_context();
+        if (m_arrangement_rec) {
+            m_arrangement_rec->m_branch_terms.push_back(term);
+            m_arrangement_rec->m_branch_priorities.push_back(priority);
+            m_arrangement_rec->m_branch_phases.push_back(phase);
+        }
         ctx.internalize(term, false);
         bool_var v = ctx.get_bool_var(term);
         ctx.add_theory_aware_branching_info(v, priority, phase);
@@ -2685,6 +2906,118 @@ namespace smt {
         ctx.mk_th_case_split(ls.size(), ls.c_ptr());
     }
 
+    // the memoised arrangements are discarded when there are more than this many.
+    static const unsigned max_memoised_arrangements = 4096;
+
+    /*
+     * Assert that the concat equality concatAst1 = concatAst2 implies one of the
+     * arrangements in arrangement_disjunction, and that the arrangements are mutually exclusive.
+     * Arrangements that do not rely on the overlap assumption are memoised, so that
+     * the same equality does not need to be split again after backtracking.
+     */
+    void theory_str::assert_arrangement(expr * concatAst1, expr * concatAst2, expr_ref_vector & arrangement_disjunction) {
+        context & ctx = get_context();
+        ast_manager & mgr = get_manager();
+        expr_ref premise(ctx.mk_eq_atom(concatAst1, concatAst2), mgr);
+        expr_ref conclusion(mk_or(arrangement_disjunction), mgr);
+        if (m_params.m_StrongArrangements) {
+            expr_ref ax_strong(ctx.mk_eq_atom(premise, conclusion), mgr);
+            assert_axiom(ax_strong);
+        } else {
+            assert_implication(premise, conclusion);
+        }
+        // assert mutual exclusion between each branch of the arrangement
+        generate_mutual_exclusion(arrangement_disjunction);
+        m_stats.m_num_arrangements++;
+
+        // arrangements that depend on loop detection or on the overlap assumption are not memoised.
+        if (m_arrangement_rec == nullptr || 
+            m_arrangement_rec->m_self_cut || 
+            arrangement_disjunction.contains(m_theoryStrOverlapAssumption_term)) {
+            return;
+        }
+        expr * lhs = concatAst1, * rhs = concatAst2;
+        if (lhs->get_id() > rhs->get_id()) {
+            std::swap(lhs, rhs);
+        }
+        if (m_arrangement_cache.contains(lhs, rhs)) {
+            return;
+        }
+        if (m_arrangements.size() >= max_memoised_arrangements) {
+            reset_arrangements();
+        }
+        arrangement * a = alloc(arrangement, *m_arrangement_rec);
+        a->m_lhs = concatAst1;
+        a->m_rhs = concatAst2;
+        a->m_options.append(arrangement_disjunction.size(), arrangement_disjunction.c_ptr());
+        m_arrangement_trail.append(a->m_options.size(), a->m_options.c_ptr());
+        m_arrangement_trail.append(a->m_branch_terms.size(), a->m_branch_terms.c_ptr());
+        m_arrangement_trail.append(a->m_nonempty_vars.size(), a->m_nonempty_vars.c_ptr());
+        for (auto const& p : a->m_cut_merges) {
+            m_arrangement_trail.push_back(p.first);
+            m_arrangement_trail.push_back(p.second);
+        }
+        for (auto const& p : a->m_self_cut_checks) {
+            m_arrangement_trail.push_back(p.first);
+            m_arrangement_trail.push_back(p.second);
+        }
+        m_arrangement_trail.push_back(concatAst1);
+        m_arrangement_trail.push_back(concatAst2);
+        m_arrangement_cache.insert(lhs, rhs, m_arrangements.size());
+        m_arrangements.push_back(a);
+    }
+
+    /*
+     * Re-assert the memoised arrangement of concatAst1 = concatAst2, if there is one.
+     */
+    bool theory_str::replay_arrangement(expr * concatAst1, expr * concatAst2) {
+        expr * lhs = concatAst1, * rhs = concatAst2;
+        if (lhs->get_id() > rhs->get_id()) {
+            std::swap(lhs, rhs);
+        }
+        unsigned idx;
+        if (!m_arrangement_cache.find(lhs, rhs, idx)) {
+            return false;
+        }
+        arrangement const & a = *m_arrangements[idx];
+        for (auto const& p : a.m_cut_merges) {
+            if (!cut_var_map.contains(p.second) || cut_var_map[p.second].empty()) {
+                // the cut information of the source was not initialized in this branch.
+                return false;
+            }
+        }
+        for (auto const& p : a.m_self_cut_checks) {
+            if (has_self_cut(p.first, p.second)) {
+                // a loop is detected in this branch, the arrangement is generated again.
+                return false;
+            }
+        }
+        TRACE("str", tout << "replay arrangement of " << mk_pp(a.m_lhs, get_manager()) << " = " << mk_pp(a.m_rhs, get_manager()) << std::endl;);
+        for (expr * v : a.m_nonempty_vars) {
+            refresh_theory_var(v);
+            add_nonempty_constraint(v);
+        }
+        for (auto const& p : a.m_cut_merges) {
+            add_cut_info_merge(p.first, sLevel, p.second);
+        }
+        expr_ref_vector arrangement_disjunction(get_manager());
+        for (expr * e : a.m_options) {
+            arrangement_disjunction.push_back(e);
+        }
+        for (unsigned i = 0; i < a.m_branch_terms.size(); ++i) {
+            add_theory_aware_branching_info(a.m_branch_terms[i], a.m_branch_priorities[i], a.m_branch_phases[i]);
+        }
+        assert_arrangement(a.m_lhs, a.m_rhs, arrangement_disjunction);
+        m_stats.m_num_arrangement_replays++;
+        return true;
+    }
+
+    void theory_str::reset_arrangements() {
+        m_arrangements.reset();
+        m_arrangement_cache.reset();
+        m_arrangement_trail.reset();
+    }
+
     void theory_str::print_cut_var(expr * node, std::ofstream & xout) {
         ast_manager & m = get_manager();
         xout << "Cut info of " << mk_pp(node, m) << std::endl;
@@ -2893,6 +3226,13 @@ namespace smt {
         check_and_init_cut_var(v2_arg0);
         check_and_init_cut_var(v2_arg1);
 
+        if (replay_arrangement(new_nn1, new_nn2)) {
+            return;
+        }
+        // record the side effects of generating an arrangement, so that it can be replayed
+        arrangement rec;
+        flet<arrangement*> _rec(m_arrangement_rec, &rec);
+
         //*************************************************************
               // case 1: concat(x, y) = concat(m, n)
               //*************************************************************
@@ -3487,16 +3827,7 @@ namespace smt {
             }
 
             if (!arrangement_disjunction.empty()) {
-                expr_ref premise(ctx.mk_eq_atom(concatAst1, concatAst2), mgr);
-                expr_ref conclusion(mk_or(arrangement_disjunction), mgr);
-                if (m_params.m_StrongArrangements) {
-                    expr_ref ax_strong(ctx.mk_eq_atom(premise, conclusion), mgr);
-                    assert_axiom(ax_strong);
-                } else {
-                    assert_implication(premise, conclusion);
-                }
-                // assert mutual exclusion between each branch of the arrangement
-                generate_mutual_exclusion(arrangement_disjunction);
+                assert_arrangement(concatAst1, concatAst2, arrangement_disjunction);
             } else {
                 TRACE("str", tout << "STOP: no split option found for two EQ concats." << std::endl;);
             }
@@ -3850,16 +4181,7 @@ namespace smt {
             }
 
             if (!arrangement_disjunction.empty()) {
-                expr_ref implyR(mk_or(arrangement_disjunction), mgr);
-
-                if (m_params.m_StrongArrangements) {
-                    expr_ref implyLHS(ctx.mk_eq_atom(concatAst1, concatAst2), mgr);
-                    expr_ref ax_strong(ctx.mk_eq_atom(implyLHS, implyR), mgr);
-                    assert_axiom(ax_strong);
-                } else {
-                    assert_implication(ctx.mk_eq_atom(concatAst1, concatAst2), implyR);
-                }
-                generate_mutual_exclusion(arrangement_disjunction);
+                assert_arrangement(concatAst1, concatAst2, arrangement_disjunction);
             } else {
                 TRACE("str", tout << "STOP: Should not split two EQ concats." << std::endl;);
             }
@@ -4212,16 +4534,7 @@ namespace smt {
 
 
             if (!arrangement_disjunction.empty()) {
-                expr_ref implyR(mk_or(arrangement_disjunction), mgr);
-
-                if (m_params.m_StrongArrangements) {
-                    expr_ref ax_lhs(ctx.mk_eq_atom(concatAst1, concatAst2), mgr);
-                    expr_ref ax_strong(ctx.mk_eq_atom(ax_lhs, implyR), mgr);
-                    assert_axiom(ax_strong);
-                } else {
-                    assert_implication(ctx.mk_eq_atom(concatAst1, concatAst2), implyR);
-                }
-                generate_mutual_exclusion(arrangement_disjunction);
+                assert_arrangement(concatAst1, concatAst2, arrangement_disjunction);
             } else {
                 TRACE("str", tout << "STOP: should not split two eq. concats" << std::endl;);
             }
@@ -8425,6 +8738,11 @@ namespace smt {
             set_up_axioms(ex);
         }
 
+        if (m_params.m_LengthPresolve && nFormulas != m_length_presolve_num_formulas) {
+            m_length_presolve_num_formulas = nFormulas;
+            length_presolve();
+        }
+
         // this might be cheating but we need to make sure that certain maps are populated
         // before the first call to new_eq_eh()
         propagate();
@@ -11975,6 +12293,11 @@ namespace smt {
                     midPoint = freeVar_len_value;
                     upperBound = midPoint * 2;
                     windowSize = upperBound;
+                } else if (m_length_hints.find(freeVar, freeVar_len_value)) {
+                    TRACE("str", tout << "length abstraction suggests length " << freeVar_len_value << " for freeVar" << std::endl;);
+                    midPoint = freeVar_len_value;
+                    upperBound = midPoint * 2;
+                    windowSize = upperBound;
                 }
             }
 
@@ -12419,6 +12742,13 @@ namespace smt {
 
     void theory_str::finalize_model(model_generator & mg) {}
 
+    void theory_str::collect_statistics(::statistics & st) const {
+        st.update("str arrangements", m_stats.m_num_arrangements);
+        st.update("str replayed arrangements", m_stats.m_num_arrangement_replays);
+        st.update("str length presolve unsat", m_stats.m_num_length_presolve_unsat);
+        st.update("str length hints", m_stats.m_num_length_hints);
+    }
+
     void theory_str::display(std::ostream & out) const {
         out << "TODO: theory_str display" << std::endl;
     }
@@ -230,11 +230,6 @@ class theory_str : public theory {
     typedef union_find<theory_str> th_union_find;
 
     typedef map<rational, expr*, obj_hash<rational>, default_eq<rational> > rational_map;
-    struct zstring_hash_proc {
-        unsigned operator()(zstring const & s) const {
-            return string_hash(s.encode().c_str(), static_cast<unsigned>(s.length()), 17);
-        }
-    };
     typedef map<zstring, expr*, zstring_hash_proc, default_eq<zstring> > string_map;
 
 protected:
@@ -357,6 +352,47 @@ protected:
     scoped_ptr_vector<T_cut> m_cut_allocs;
     expr_ref m_theoryStrOverlapAssumption_term;
 
+    /*
+     * Arrangement of a concat equality, memoised across scopes.
+     * Replaying it asserts the same disjunction and repeats the cut information
+     * and branching hints that were recorded when it was first generated.
+     */
+    struct arrangement {
+        expr *                            m_lhs;
+        expr *                            m_rhs;
+        ptr_vector<expr>                  m_options;
+        ptr_vector<expr>                  m_nonempty_vars;
+        svector<std::pair<expr*, expr*> > m_cut_merges; // (destination, source)
+        svector<std::pair<expr*, expr*> > m_self_cut_checks; // has_self_cut tests that were false
+        bool                              m_self_cut;        // a has_self_cut test was true
+        ptr_vector<expr>                  m_branch_terms;
+        svector<double>                   m_branch_priorities;
+        svector<lbool>                    m_branch_phases;
+        arrangement(): m_lhs(nullptr), m_rhs(nullptr), m_self_cut(false) {}
+    };
+    scoped_ptr_vector<arrangement>     m_arrangements;
+    obj_pair_map<expr, expr, unsigned> m_arrangement_cache; // canonical (lhs, rhs) -> index in m_arrangements
+    expr_ref_vector                    m_arrangement_trail; // terms of the memoised arrangements
+    arrangement *                      m_arrangement_rec;   // arrangement being generated, or nullptr
+    // axioms already kept alive by m_trail
+    obj_hashtable<expr>                m_trail_axioms;
+
+    struct stats {
+        stats() { reset(); }
+        void reset() { memset(this, 0, sizeof(stats)); }
+        unsigned m_num_arrangements;
+        unsigned m_num_arrangement_replays;
+        unsigned m_num_length_presolve_unsat;
+        unsigned m_num_length_hints;
+    };
+    stats m_stats;
+
+    // lengths of string variables in a model of the length abstraction of the input
+    obj_map<expr, rational> m_length_hints;
+    expr_ref_vector         m_length_hint_vars;
+    // number of asserted formulas when the length abstraction was last checked
+    unsigned                m_length_presolve_num_formulas;
+
     obj_hashtable<expr> variable_set;
     obj_hashtable<expr> internal_variable_set;
     obj_hashtable<expr> regex_variable_set;
@@ -504,6 +540,7 @@ protected:
     void add_cut_info_one_node(expr * baseNode, int slevel, expr * node);
     void add_cut_info_merge(expr * destNode, int slevel, expr * srcNode);
     bool has_self_cut(expr * n1, expr * n2);
+    bool has_self_cut_core(expr * n1, expr * n2);
 
     // for ConcatOverlapAvoid
     bool will_result_in_overlap(expr * lhs, expr * rhs);
@@ -635,6 +672,11 @@ protected:
 
     void generate_mutual_exclusion(expr_ref_vector & exprs);
     void add_theory_aware_branching_info(expr * term, double priority, lbool phase);
+    void assert_arrangement(expr * concatAst1, expr * concatAst2, expr_ref_vector & arrangement_disjunction);
+    bool replay_arrangement(expr * concatAst1, expr * concatAst2);
+    void reset_arrangements();
+
+    void length_presolve();
 
     bool new_eq_check(expr * lhs, expr * rhs);
     void group_terms_by_eqc(expr * n, std::set<expr*> & concats, std::set<expr*> & vars, std::set<expr*> & consts);
@@ -722,6 +764,7 @@ public:
 
     char const * get_name() const override { return "seq"; }
     void display(std::ostream & out) const override;
+    void collect_statistics(::statistics & st) const override;
 
     bool overlapping_variables_detected() const { return loopDetected; }
 
@@ -20,6 +20,7 @@ Notes:
 #include "tactic/goal.h"
 #include "ast/ast_smt2_pp.h"
 #include "util/cooperate.h"
+#include "sat/sat_solver.h"
 
 #define USE_TWO_LEVEL_RULES
 #define FIRST_NODE_ID (UINT_MAX/2)
@@ -1298,6 +1299,278 @@ struct aig_manager::imp {
         }
     };
 
+    /**
+       \brief Functional reduction (FRAIG sweeping).
+
+       The nodes are partitioned by their values on random input patterns,
+       modulo complementation. The members of each class are checked against
+       the first node of the class (in topological order) by a SAT solver
+       with a total budget of conflicts, and the graph is rebuilt with the
+       nodes that were proved equivalent merged.
+    */
+    struct fraig_proc {
+        static const unsigned NUM_WORDS = 4;
+        imp &                  m;
+        ptr_vector<aig>        m_nodes;    // children before parents
+        u_map<unsigned>        m_id2pos;
+        svector<uint64_t>      m_sim;      // NUM_WORDS words per node
+        unsigned_vector        m_repr;     // position of the representative, or UINT_MAX
+        svector<bool>          m_flip;     // node is the negation of its representative
+        svector<aig_lit>       m_new;
+        ptr_vector<aig>        m_saved;
+        params_ref             m_params;
+        scoped_ptr<sat::solver> m_solver;
+        svector<sat::bool_var> m_vars;
+        unsigned               m_max_checks;
+        unsigned               m_num_checks;
+        unsigned               m_num_merged;
+
+        fraig_proc(imp & _m, unsigned max_conflicts, unsigned max_checks):
+            m(_m),
+            m_max_checks(max_checks),
+            m_num_checks(0),
+            m_num_merged(0) {
+            m_params.set_uint("max_conflicts", max_conflicts);
+        }
+
+        ~fraig_proc() {
+            m.dec_array_ref(m_saved.size(), m_saved.c_ptr());
+        }
+
+        unsigned pos(aig_lit const & l) const {
+            unsigned p = UINT_MAX;
+            m_id2pos.find(l.ptr()->m_id, p);
+            SASSERT(p != UINT_MAX);
+            return p;
+        }
+
+        void add_node(aig * n) {
+            n->m_mark = true;
+            m_id2pos.insert(n->m_id, m_nodes.size());
+            m_nodes.push_back(n);
+        }
+
+        void sort(aig * root) {
+            add_node(m.m_true.ptr());
+            ptr_vector<aig> todo;
+            todo.push_back(root);
+            while (!todo.empty()) {
+                aig * n = todo.back();
+                if (n->m_mark) {
+                    todo.pop_back();
+                    continue;
+                }
+                bool visited = true;
+                if (!is_var(n)) {
+                    for (unsigned i = 0; i < 2; i++) {
+                        aig * c = n->m_children[i].ptr();
+                        if (!c->m_mark) {
+                            todo.push_back(c);
+                            visited = false;
+                        }
+                    }
+                }
+                if (visited) {
+                    todo.pop_back();
+                    add_node(n);
+                }
+            }
+            unmark(m_nodes.size(), m_nodes.c_ptr());
+        }
+
+        uint64_t sim(aig_lit const & l, unsigned w) const {
+            uint64_t v = m_sim[pos(l) * NUM_WORDS + w];
+            return l.is_inverted() ? ~v : v;
+        }
+
+        bool phase(unsigned i) const { return (m_sim[i * NUM_WORDS] & 1) != 0; }
+
+        uint64_t canonical(unsigned i, unsigned w) const {
+            uint64_t v = m_sim[i * NUM_WORDS + w];
+            return phase(i) ? ~v : v;
+        }
+
+        void simulate() {
+            random_gen rand(m_nodes.size());
+            m_sim.resize(m_nodes.size() * NUM_WORDS, 0);
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                aig * n = m_nodes[i];
+                for (unsigned w = 0; w < NUM_WORDS; w++) {
+                    uint64_t v;
+                    if (n->m_id == 0) {
+                        v = ~static_cast<uint64_t>(0);
+                    }
+                    else if (is_var(n)) {
+                        v = 0;
+                        for (unsigned k = 0; k < 5; k++)
+                            v = (v << 15) | static_cast<uint64_t>(rand());
+                    }
+                    else {
+                        v = sim(left(n), w) & sim(right(n), w);
+                    }
+                    m_sim[i * NUM_WORDS + w] = v;
+                }
+            }
+        }
+
+        bool same_class(unsigned i, unsigned j) const {
+            for (unsigned w = 0; w < NUM_WORDS; w++)
+                if (canonical(i, w) != canonical(j, w))
+                    return false;
+            return true;
+        }
+
+        struct sim_lt {
+            fraig_proc const & p;
+            sim_lt(fraig_proc const & p):p(p) {}
+            bool operator()(unsigned i, unsigned j) const {
+                for (unsigned w = 0; w < NUM_WORDS; w++) {
+                    uint64_t a = p.canonical(i, w);
+                    uint64_t b = p.canonical(j, w);
+                    if (a != b)
+                        return a < b;
+                }
+                return i < j;
+            }
+        };
+
+        sat::literal lit(aig_lit const & l) const {
+            sat::literal r(m_vars[pos(l)], false);
+            return l.is_inverted() ? ~r : r;
+        }
+
+        void encode() {
+            m_solver = alloc(sat::solver, m_params, m.m().limit(), nullptr);
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                aig * n = m_nodes[i];
+                // external variables are not eliminated by the solver, so they can be assumed later.
+                sat::bool_var v = m_solver->mk_var(true);
+                m_vars.push_back(v);
+                sat::literal x(v, false);
+                if (n->m_id == 0) {
+                    m_solver->mk_clause(1, &x);
+                }
+                else if (!is_var(n)) {
+                    sat::literal a = lit(left(n));
+                    sat::literal b = lit(right(n));
+                    m_solver->mk_clause(~x, a);
+                    m_solver->mk_clause(~x, b);
+                    m_solver->mk_clause(x, ~a, ~b);
+                }
+            }
+        }
+
+        lbool is_equiv(sat::literal a, sat::literal b) {
+            sat::literal asms[2] = { a, ~b };
+            lbool r = m_solver->check(2, asms);
+            if (r != l_false)
+                return r == l_true ? l_false : l_undef;
+            asms[0] = ~a;
+            asms[1] = b;
+            r = m_solver->check(2, asms);
+            if (r != l_false)
+                return r == l_true ? l_false : l_undef;
+            return l_true;
+        }
+
+        /**
+           \brief Try to merge the node at position i into the node at position rep.
+           Return false if the budget is exhausted.
+        */
+        bool merge(unsigned rep, unsigned i) {
+            if (m_num_checks >= m_max_checks)
+                return false;
+            m_num_checks++;
+            m.checkpoint();
+            if (!m_solver)
+                encode();
+            bool flip = phase(rep) != phase(i);
+            sat::literal a(m_vars[rep], false);
+            sat::literal b(m_vars[i], flip);
+            switch (is_equiv(a, b)) {
+            case l_true:
+                m_repr[i] = rep;
+                m_flip[i] = flip;
+                m_num_merged++;
+                return true;
+            case l_false:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        void find_equivalences() {
+            unsigned sz = m_nodes.size();
+            m_repr.resize(sz, UINT_MAX);
+            m_flip.resize(sz, false);
+            unsigned_vector order;
+            for (unsigned i = 0; i < sz; i++)
+                order.push_back(i);
+            std::sort(order.begin(), order.end(), sim_lt(*this));
+            unsigned start = 0;
+            for (unsigned k = 1; k <= sz; k++) {
+                if (k < sz && same_class(order[start], order[k]))
+                    continue;
+                // order[start] is the first node of the class in topological order.
+                for (unsigned j = start + 1; j < k; j++) {
+                    if (!merge(order[start], order[j]))
+                        return;
+                }
+                start = k;
+            }
+        }
+
+        aig_lit translate(aig_lit const & l) const {
+            aig_lit r = m_new[pos(l)];
+            if (l.is_inverted())
+                r.invert();
+            return r;
+        }
+
+        void rebuild() {
+            for (unsigned i = 0; i < m_nodes.size(); i++) {
+                aig * n = m_nodes[i];
+                aig_lit r;
+                if (m_repr[i] != UINT_MAX) {
+                    r = m_new[m_repr[i]];
+                    if (m_flip[i])
+                        r.invert();
+                }
+                else if (is_var(n)) {
+                    r = aig_lit(n);
+                }
+                else {
+                    r = m.mk_node(translate(left(n)), translate(right(n)));
+                    m.checkpoint();
+                }
+                m.inc_ref(r);
+                m_saved.push_back(r.ptr());
+                m_new.push_back(r);
+            }
+        }
+
+        aig_lit operator()(aig_lit root) {
+            if (is_var(root))
+                return root;
+            sort(root.ptr());
+            simulate();
+            find_equivalences();
+            IF_VERBOSE(10, verbose_stream() << "(aig.fraig :nodes " << m_nodes.size() << " :checks " << m_num_checks
+                       << " :merged " << m_num_merged << ")\n";);
+            if (m_num_merged == 0)
+                return root;
+            rebuild();
+            aig_lit r = translate(root);
+            m.inc_ref(r);
+            m.dec_array_ref(m_saved.size(), m_saved.c_ptr());
+            m_saved.reset();
+            m.dec_ref_result(r);
+            return r;
+        }
+    };
+
+
 public:
     imp(ast_manager & m, unsigned long long max_memory, bool default_gate_encoding):
         m_var_id_gen(0),
@@ -1545,6 +1818,11 @@ public:
         return p(l);
     }
 
+    aig_lit fraig(aig_lit l, unsigned max_conflicts, unsigned max_checks) {
+        fraig_proc p(*this, max_conflicts, max_checks);
+        return p(l);
+    }
+
     void display_ref(std::ostream & out, aig * r) const {
         if (is_var(r)) 
             out << "#" << r->m_id;
@@ -1726,6 +2004,10 @@ void aig_manager::max_sharing(aig_ref & r) {
     r = aig_ref(*this, m_imp->max_sharing(aig_lit(r)));
 }
 
+void aig_manager::fraig(aig_ref & r, unsigned max_conflicts, unsigned max_checks) {
+    r = aig_ref(*this, m_imp->fraig(aig_lit(r), max_conflicts, max_checks));
+}
+
 void aig_manager::to_formula(aig_ref const & r, goal & g) {
     SASSERT(!g.proofs_enabled());
     SASSERT(!g.unsat_core_enabled());
@@ -68,6 +68,10 @@ public:
     aig_ref mk_iff(aig_ref const & r1, aig_ref const & r2);
     aig_ref mk_ite(aig_ref const & r1, aig_ref const & r2, aig_ref const & r3);
     void max_sharing(aig_ref & r);
+    // Merge the nodes that are functionally equivalent (modulo negation).
+    // Candidates are found by random simulation and proved by a SAT solver
+    // using at most max_conflicts conflicts and max_checks queries in total.
+    void fraig(aig_ref & r, unsigned max_conflicts = 10000, unsigned max_checks = 10000);
     void to_formula(aig_ref const & r, expr_ref & result);
     void to_formula(aig_ref const & r, goal & result);
     void display(std::ostream & out, aig_ref const & r) const;
@@ -38,6 +38,63 @@ class sls_evaluator {
     vector<ptr_vector<expr> > m_traversal_stack;
     vector<ptr_vector<expr> > m_traversal_stack_bool;
 
+    /**
+       \brief Evaluate arithmetic and bitwise operators over bit-vectors of width at most 64
+       using machine arithmetic. Return false if the operator or width is not handled.
+    */
+    bool run_bv64(bv_op_kind k, app * n, mpz & result) {
+        switch (k) {
+        case OP_BADD: case OP_BSUB: case OP_BMUL: case OP_BNEG:
+        case OP_BAND: case OP_BOR: case OP_BXOR: case OP_BNOT: case OP_BNAND: case OP_BNOR:
+        case OP_BUDIV: case OP_BUDIV0: case OP_BUDIV_I:
+        case OP_BUREM: case OP_BUREM0: case OP_BUREM_I:
+            break;
+        default:
+            return false;
+        }
+        unsigned bv_sz = m_bv_util.get_bv_size(n);
+        unsigned n_args = n->get_num_args();
+        if (bv_sz > 64 || n_args == 0)
+            return false;
+        if ((k == OP_BNEG || k == OP_BNOT) != (n_args == 1))
+            return false;
+        if ((k == OP_BNAND || k == OP_BNOR) && n_args != 2)
+            return false;
+        uint64_t mask = bv_sz == 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << bv_sz) - 1;
+        const mpz & v0 = m_tracker.get_value(n->get_arg(0));
+        if (!m_mpz_manager.is_uint64(v0))
+            return false;
+        uint64_t a = m_mpz_manager.get_uint64(v0);
+        if (k == OP_BNEG)
+            a = 0 - a;
+        else if (k == OP_BNOT)
+            a = ~a;
+        for (unsigned i = 1; i < n_args; i++) {
+            const mpz & v = m_tracker.get_value(n->get_arg(i));
+            if (!m_mpz_manager.is_uint64(v))
+                return false;
+            uint64_t b = m_mpz_manager.get_uint64(v);
+            switch (k) {
+            case OP_BADD: a += b; break;
+            case OP_BSUB: a -= b; break;
+            case OP_BMUL: a *= b; break;
+            case OP_BAND: a &= b; break;
+            case OP_BOR:  a |= b; break;
+            case OP_BXOR: a ^= b; break;
+            case OP_BNAND: a = ~(a & b); break;
+            case OP_BNOR:  a = ~(a | b); break;
+            case OP_BUDIV: case OP_BUDIV0: case OP_BUDIV_I:
+                a = b == 0 ? mask : a / b;
+                break;
+            default: // OP_BUREM, OP_BUREM0, OP_BUREM_I
+                a = b == 0 ? a : a % b;
+                break;
+            }
+        }
+        m_mpz_manager.set(result, a & mask);
+        return true;
+    }
+
 public:
     sls_evaluator(ast_manager & m, bv_util & bvu, sls_tracker & t, unsynch_mpz_manager & mm, powers & p) : 
         m_manager(m), 
@@ -132,6 +189,9 @@ public:
                 NOT_IMPLEMENTED_YET();
             }
         }
+        else if (nfid == m_bv_fid && m_bv_util.is_bv(n) && run_bv64(static_cast<bv_op_kind>(fd->get_decl_kind()), n, result)) {
+            // evaluated with machine arithmetic
+        }
         else if (nfid == m_bv_fid) {
             bv_op_kind k = static_cast<bv_op_kind>(fd->get_decl_kind());
             switch(k) {
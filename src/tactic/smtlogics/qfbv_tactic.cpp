@@ -98,6 +98,7 @@ static tactic * mk_qfbv_tactic(ast_manager& m, params_ref const & p, tactic* sat
 
     params_ref big_aig_p;
     big_aig_p.set_bool("aig_per_assertion", false);
+    big_aig_p.set_bool("aig_fraig", true);
 
     tactic* preamble_st = mk_qfbv_preamble(m, p);
     tactic * st = main_p(and_then(preamble_st,
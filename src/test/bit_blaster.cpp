@@ -20,6 +20,12 @@ Revision History:
 #include "ast/rewriter/bit_blaster/bit_blaster.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/rewriter/expr_safe_replace.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "util/util.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
 
 void mk_bits(ast_manager & m, char const * prefix, unsigned sz, expr_ref_vector & r) {
     sort_ref b(m);
@@ -70,6 +76,66 @@ void tst_multiplier(ast_manager & m, unsigned sz) {
 //     TRACE("bit_blaster", display(tout, c););
 }
 
+/**
+   \brief Check that the Dadda tree multiplier is equivalent to the shift-add
+   multiplier, whichever order the operands are given in. Equivalence of
+   multipliers is hard for SAT, so wide multipliers are only compared on
+   random operands.
+*/
+void tst_dadda_multiplier(unsigned sz) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref_vector a(m), b(m), c1(m), c2(m), c3(m);
+    mk_bits(m, "a", sz, a);
+    mk_bits(m, "b", sz, b);
+    bit_blaster_params p;
+    bit_blaster shift_add(m, p);
+    p.m_bb_mul_tree_threshold = 1;
+    bit_blaster dadda(m, p);
+    shift_add.mk_multiplier(sz, a.c_ptr(), b.c_ptr(), c1);
+    dadda.mk_multiplier(sz, a.c_ptr(), b.c_ptr(), c2);
+    dadda.mk_multiplier(sz, b.c_ptr(), a.c_ptr(), c3);
+    ENSURE(c1.size() == sz && c2.size() == sz && c3.size() == sz);
+    if (sz <= 6) {
+        expr_ref_vector diff(m);
+        for (unsigned i = 0; i < sz; ++i) {
+            diff.push_back(m.mk_not(m.mk_eq(c1.get(i), c2.get(i))));
+            diff.push_back(m.mk_not(m.mk_eq(c1.get(i), c3.get(i))));
+        }
+        smt_params fp;
+        smt::kernel k(m, fp);
+        k.assert_expr(m.mk_or(diff.size(), diff.c_ptr()));
+        ENSURE(k.check() == l_false);
+        return;
+    }
+    SASSERT(sz <= 32);
+    random_gen r(sz);
+    th_rewriter rw(m);
+    for (unsigned n = 0; n < 20; ++n) {
+        uint64_t x = 0, y = 0;
+        for (unsigned k = 0; k < 3; ++k) {
+            x = (x << 15) | r();
+            y = (y << 15) | r();
+        }
+        expr_safe_replace rep(m);
+        for (unsigned i = 0; i < sz; ++i) {
+            rep.insert(a.get(i), m.mk_bool_val(((x >> i) & 1) != 0));
+            rep.insert(b.get(i), m.mk_bool_val(((y >> i) & 1) != 0));
+        }
+        uint64_t xy = x * y;
+        expr_ref_vector const* outs[3] = { &c1, &c2, &c3 };
+        for (expr_ref_vector const* c : outs) {
+            for (unsigned i = 0; i < sz; ++i) {
+                expr_ref bit(m);
+                rep(c->get(i), bit);
+                rw(bit);
+                ENSURE(m.is_true(bit) == (((xy >> i) & 1) != 0));
+                ENSURE(m.is_true(bit) || m.is_false(bit));
+            }
+        }
+    }
+}
+
 void tst_le(ast_manager & m, unsigned sz) {
 //     expr_ref_vector a(m);
 //     expr_ref_vector b(m);
@@ -120,4 +186,7 @@ void tst_bit_blaster() {
     tst_le(m, 4);
     tst_eqs(m, 8);
     tst_sh(m, 4);
+    unsigned widths[] = { 1, 2, 3, 4, 5, 6, 7, 8, 16, 32 };
+    for (unsigned sz : widths)
+        tst_dadda_multiplier(sz);
 }
@@ -41,6 +41,7 @@ Revision History:
 #include "test/test_file_reader.h"
 #include "util/lp/indexed_value.h"
 #include "util/lp/lar_solver.h"
+#include "util/lp/int_solver.h"
 #include "util/lp/numeric_pair.h"
 #include "util/lp/binary_heap_upair_queue.h"
 #include "util/lp/stacked_value.h"
@@ -1919,6 +1920,8 @@ void setup_args_parser(argument_parser & parser) {
     parser.add_option_with_help_string("--randomize_lar", "test randomize funclionality");
     parser.add_option_with_help_string("--smap", "test stacked_map");
     parser.add_option_with_help_string("--term", "simple term test");
+    parser.add_option_with_help_string("--lia", "test the GCD test and the Gomory cuts of int_solver");
+    parser.add_option_with_help_string("--pd_strategies", "presolve with double solver in the tableau strategies");
     parser.add_option_with_help_string("--eti"," run a small evidence test for total infeasibility scenario");
     parser.add_option_with_help_string("--row_inf", "forces row infeasibility search");
     parser.add_option_with_help_string("-pd", "presolve with double solver");
@@ -2738,6 +2741,226 @@ void test_term() {
     
 }
 
+// the value of sum of coeff * column + c for an assignment to the variables
+mpq eval_int_term(const lar_solver & solver, const lar_term & t, const std::unordered_map<var_index, mpq> & sol) {
+    mpq v = t.m_v;
+    for (auto const & p : t.m_coeffs) {
+        var_index vi = solver.adjust_column_index_to_term_index(p.first);
+        if (solver.is_term(vi)) {
+            const lar_term & term = solver.get_term(vi);
+            mpq tv = term.m_v;
+            for (auto const & q : term.m_coeffs)
+                tv += q.second * sol.find(q.first)->second;
+            v += p.second * tv;
+        }
+        else {
+            v += p.second * sol.find(vi)->second;
+        }
+    }
+    return v;
+}
+
+// add the constraint t >= k, where t is over the columns of the solver
+void add_int_bound(lar_solver & solver, const lar_term & t, mpq k) {
+    std::unordered_map<var_index, mpq> coeffs;
+    for (auto const & p : t.m_coeffs) {
+        var_index vi = solver.adjust_column_index_to_term_index(p.first);
+        if (solver.is_term(vi)) {
+            const lar_term & term = solver.get_term(vi);
+            k -= p.second * term.m_v;
+            for (auto const & q : term.m_coeffs)
+                coeffs[q.first] += p.second * q.second;
+        }
+        else {
+            coeffs[vi] += p.second;
+        }
+    }
+    vector<std::pair<mpq, var_index>> ls;
+    for (auto const & p : coeffs)
+        if (!p.second.is_zero())
+            ls.push_back(std::pair<mpq, var_index>(p.second, p.first));
+    if (ls.size() == 1 && abs(ls[0].first).is_one())
+        solver.add_var_bound(ls[0].second, ls[0].first.is_one() ? GE : LE, ls[0].first * k);
+    else
+        solver.add_var_bound(solver.add_term(ls, zero_of_type<mpq>()), GE, k);
+}
+
+/**
+   Branch and cut with int_solver. Every cut is checked against the integer
+   solutions in sols. Return true if an integral solution is found.
+*/
+bool solve_int(lar_solver & solver, int_solver & is, const vector<std::unordered_map<var_index, mpq>> & sols,
+               unsigned & num_cuts, unsigned & num_conflicts, unsigned depth) {
+    ENSURE(depth < 20);
+    for (unsigned round = 0; round < 100; ++round) {
+        if (solver.solve() == lp_status::INFEASIBLE)
+            return false;
+        lar_term t;
+        mpq k;
+        lia_explanation ex;
+        switch (is.check(t, k, ex)) {
+        case lia_move::ok: {
+            std::unordered_map<var_index, mpq> model;
+            solver.get_model(model);
+            for (auto const & p : model)
+                ENSURE(!solver.column_is_int(p.first) || p.second.is_int());
+            return true;
+        }
+        case lia_move::conflict:
+            ENSURE(!ex.empty());
+            ++num_conflicts;
+            return false;
+        case lia_move::cut:
+            ++num_cuts;
+            for (auto const & sol : sols)
+                ENSURE(eval_int_term(solver, t, sol) >= k);
+            add_int_bound(solver, t, k);
+            break;
+        case lia_move::branch: {
+            lar_term u;
+            for (auto const & p : t.m_coeffs)
+                u.add_to_map(p.first, -p.second);
+            solver.push();
+            add_int_bound(solver, u, -k);
+            bool r = solve_int(solver, is, sols, num_cuts, num_conflicts, depth + 1);
+            solver.pop(1);
+            if (r)
+                return true;
+            solver.push();
+            add_int_bound(solver, t, k + 1);
+            r = solve_int(solver, is, sols, num_cuts, num_conflicts, depth + 1);
+            solver.pop(1);
+            return r;
+        }
+        default:
+            ENSURE(false);
+        }
+    }
+    ENSURE(false);
+    return false;
+}
+
+std::unordered_map<var_index, mpq> int_point(var_index x, int vx, var_index y, int vy) {
+    std::unordered_map<var_index, mpq> sol;
+    sol[x] = mpq(vx);
+    sol[y] = mpq(vy);
+    return sol;
+}
+
+void test_int_solver() {
+    // 2x + 4y = 1 has no integer solutions, which the GCD test finds.
+    {
+        lar_solver solver;
+        solver.settings().simplex_strategy() = simplex_strategy_enum::tableau_rows;
+        var_index x = solver.add_var(0, true);
+        var_index y = solver.add_var(1, true);
+        vector<std::pair<mpq, var_index>> ls;
+        ls.push_back(std::pair<mpq, var_index>(mpq(2), x));
+        ls.push_back(std::pair<mpq, var_index>(mpq(4), y));
+        var_index t = solver.add_term(ls, zero_of_type<mpq>());
+        solver.add_var_bound(t, EQ, mpq(1));
+        int_solver is(solver);
+        unsigned num_cuts = 0, num_conflicts = 0;
+        vector<std::unordered_map<var_index, mpq>> sols;
+        ENSURE(!solve_int(solver, is, sols, num_cuts, num_conflicts, 0));
+        ENSURE(num_conflicts == 1);
+    }
+    // 6x + 9y = 3 has the integer solutions x = 2 + 3n, y = -1 - 2n.
+    {
+        lar_solver solver;
+        solver.settings().simplex_strategy() = simplex_strategy_enum::tableau_rows;
+        var_index x = solver.add_var(0, true);
+        var_index y = solver.add_var(1, true);
+        vector<std::pair<mpq, var_index>> ls;
+        ls.push_back(std::pair<mpq, var_index>(mpq(6), x));
+        ls.push_back(std::pair<mpq, var_index>(mpq(9), y));
+        var_index t = solver.add_term(ls, zero_of_type<mpq>());
+        solver.add_var_bound(t, EQ, mpq(3));
+        solver.add_var_bound(x, GE, mpq(0));
+        solver.add_var_bound(x, LE, mpq(10));
+        int_solver is(solver);
+        unsigned num_cuts = 0, num_conflicts = 0;
+        vector<std::unordered_map<var_index, mpq>> sols;
+        sols.push_back(int_point(x, 2, y, -1));
+        sols.push_back(int_point(x, 5, y, -3));
+        sols.push_back(int_point(x, 8, y, -5));
+        ENSURE(solve_int(solver, is, sols, num_cuts, num_conflicts, 0));
+    }
+    // 1 <= 2x - 2y <= 3 and 3 <= 2x + 4y <= 7 over a box, with a Gomory cut on every check.
+    {
+        lar_solver solver;
+        solver.settings().simplex_strategy() = simplex_strategy_enum::tableau_rows;
+        solver.settings().m_int_branch_cut_ratio = 1;
+        var_index x = solver.add_var(0, true);
+        var_index y = solver.add_var(1, true);
+        vector<std::pair<mpq, var_index>> ls;
+        ls.push_back(std::pair<mpq, var_index>(mpq(2), x));
+        ls.push_back(std::pair<mpq, var_index>(mpq(-2), y));
+        var_index t1 = solver.add_term(ls, zero_of_type<mpq>());
+        solver.add_var_bound(t1, GE, mpq(1));
+        solver.add_var_bound(t1, LE, mpq(3));
+        ls.clear();
+        ls.push_back(std::pair<mpq, var_index>(mpq(2), x));
+        ls.push_back(std::pair<mpq, var_index>(mpq(4), y));
+        var_index t2 = solver.add_term(ls, zero_of_type<mpq>());
+        solver.add_var_bound(t2, GE, mpq(3));
+        solver.add_var_bound(t2, LE, mpq(7));
+        solver.add_var_bound(x, LE, mpq(5));
+        solver.add_var_bound(y, GE, mpq(-5));
+        int_solver is(solver);
+        unsigned num_cuts = 0, num_conflicts = 0;
+        vector<std::unordered_map<var_index, mpq>> sols;
+        sols.push_back(int_point(x, 2, y, 1));
+        sols.push_back(int_point(x, 3, y, 0));
+        ENSURE(solve_int(solver, is, sols, num_cuts, num_conflicts, 0));
+        ENSURE(num_cuts > 0);
+    }
+}
+
+lp_status solve_with_strategy(simplex_strategy_enum strategy, bool presolve, unsigned num_bounds) {
+    lar_solver solver;
+    solver.settings().simplex_strategy() = strategy;
+    solver.settings().presolve_with_double_solver_for_lar = presolve;
+    // the double presolve is only used with the tableau_rows strategy
+    ENSURE(solver.m_mpq_lar_core_solver.need_to_presolve_with_double_solver() ==
+           (presolve && strategy == simplex_strategy_enum::tableau_rows));
+    var_index x = solver.add_var(0);
+    var_index y = solver.add_var(1);
+    var_index z = solver.add_var(2);
+    var_index w = solver.add_var(3);
+    int coeffs[5][4] = { { 1, 1, 1, 0 }, { 2, -1, 0, 0 }, { 0, 3, -1, 1 }, { 0, 0, 1, -1 }, { 1, 1, 1, 1 } };
+    lconstraint_kind kinds[5] = { GE, LE, GE, GE, LE };
+    int rhs[5] = { 3, 1, 2, 5, 10 };
+    var_index vars[4] = { x, y, z, w };
+    for (unsigned i = 0; i < 5; i++) {
+        vector<std::pair<mpq, var_index>> ls;
+        for (unsigned j = 0; j < 4; j++)
+            if (coeffs[i][j] != 0)
+                ls.push_back(std::pair<mpq, var_index>(mpq(coeffs[i][j]), vars[j]));
+        var_index t = solver.add_term(ls, zero_of_type<mpq>());
+        solver.add_var_bound(t, kinds[i], mpq(rhs[i]));
+    }
+    lp_status st = solver.find_feasible_solution();
+    ENSURE(st != lp_status::INFEASIBLE);
+    solver.push();
+    solver.add_var_bound(x, GE, mpq(num_bounds));
+    solver.add_var_bound(w, LE, mpq(-1));
+    st = solver.find_feasible_solution();
+    solver.pop(1);
+    ENSURE(solver.find_feasible_solution() != lp_status::INFEASIBLE);
+    return st;
+}
+
+void test_presolve_with_doubles() {
+    simplex_strategy_enum strategies[2] = { simplex_strategy_enum::tableau_rows, simplex_strategy_enum::tableau_costs };
+    for (simplex_strategy_enum strategy : strategies) {
+        for (unsigned k = 0; k < 4; k++) {
+            lp_status st = solve_with_strategy(strategy, false, k);
+            ENSURE((st == lp_status::INFEASIBLE) == (solve_with_strategy(strategy, true, k) == lp_status::INFEASIBLE));
+        }
+    }
+}
+
 void test_evidence_for_total_inf_simple(argument_parser & args_parser) {
     lar_solver solver;
     var_index x = solver.add_var(0);
@@ -3217,6 +3440,16 @@ void test_lp_local(int argn, char**argv) {
         ret = 0;
         return finalize(ret);
     }
+    if (args_parser.option_is_used("--pd_strategies")) {
+        test_presolve_with_doubles();
+        ret = 0;
+        return finalize(ret);
+    }
+    if (args_parser.option_is_used("--lia")) {
+        test_int_solver();
+        ret = 0;
+        return finalize(ret);
+    }
     unsigned max_iters;
     unsigned time_limit;
     get_time_limit_and_max_iters_from_parser(args_parser, time_limit, max_iters);
@@ -196,6 +196,7 @@ int main(int argc, char ** argv) {
     TST(arith_rewriter);
     TST(check_assumptions);
     TST(smt_context);
+    TST(smt_context_core_cache);
     TST(theory_dl);
     TST(model_retrieval);
     TST(model_based_opt);
@@ -235,8 +236,10 @@ int main(int argc, char ** argv) {
     TST(expr_substitution);
     TST(sorting_network);
     TST(theory_pb);
+    TST(theory_str);
     TST(simplex);
     TST(sat_user_scope);
+    TST(seq_rewriter);
     TST(pdr);
     TST_ARGV(ddnf);
     TST(ddnf1);
@@ -245,6 +248,7 @@ int main(int argc, char ** argv) {
     TST(get_consequences);
     TST(pb2bv);
     TST_ARGV(cnf_backbones);
+    TST(zstring);
     //TST_ARGV(hs);
 }
 
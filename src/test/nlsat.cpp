@@ -24,6 +24,8 @@ Notes:
 #include "nlsat/nlsat_explain.h"
 #include "math/polynomial/polynomial_cache.h"
 #include "util/rlimit.h"
+#include "api/z3.h"
+#include <string>
 
 nlsat::interval_set_ref tst_interval(nlsat::interval_set_ref const & s1,
                                      nlsat::interval_set_ref const & s2,
@@ -695,7 +697,37 @@ static void tst10() {
     std::cout << "\n";
 }
 
+static void tst_nlsat_parallel(char const * script, char const * expected) {
+    char const * max_conflicts[4] = { "1", "2", "20", "400" };
+    for (char const * mc : max_conflicts) {
+        Z3_global_param_set("nlsat.threads", "4");
+        Z3_global_param_set("nlsat.threads.max_conflicts", mc);
+        Z3_context ctx = Z3_mk_context(nullptr);
+        std::string result = Z3_eval_smtlib2_string(ctx, script);
+        std::cout << "max_conflicts " << mc << ": " << result;
+        Z3_del_context(ctx);
+        Z3_global_param_reset_all();
+        ENSURE(result == expected);
+    }
+}
+
+static void tst_parallel() {
+    tst_nlsat_parallel("(declare-const x Real)(declare-const y Real)(declare-const z Real)\n"
+                       "(assert (>= (+ (* -3 x z) 4) 0))\n"
+                       "(assert (or (>= (* 5 x) 0) (< (* 4 y) 0)))\n"
+                       "(assert (> (- y (* 4 x y)) 0))\n"
+                       "(assert (<= (+ (* -4 x x y) (* z z) z 5) 0))\n"
+                       "(assert (or (= (* 2 y y z) 1) (> (* x x z) 1)))\n"
+                       "(check-sat-using qfnra-nlsat)\n", "sat\n");
+    tst_nlsat_parallel("(declare-const x Real)(declare-const y Real)\n"
+                       "(assert (> (* x y) 1))\n"
+                       "(assert (< (+ (* x x) (* y y)) 2))\n"
+                       "(check-sat-using qfnra-nlsat)\n", "unsat\n");
+}
+
 void tst_nlsat() {
+    tst_parallel();
+    std::cout << "------------------\n";
     tst10();
     std::cout << "------------------\n";
     tst9();
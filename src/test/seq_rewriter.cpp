@@ -0,0 +1,272 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    seq_rewriter.cpp
+
+Abstract:
+
+    Test the automata and the derivatives built from regular expressions
+    against the languages of the expressions over a small alphabet.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include<set>
+#include<string>
+#include "api/z3.h"
+#include "ast/ast_pp.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/rewriter/seq_rewriter.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+
+typedef std::set<std::string> lang;
+
+static const unsigned max_len = 3;
+static char const* alphabet = "abc";
+
+static lang all_words() {
+    lang r;
+    r.insert("");
+    lang frontier = r;
+    for (unsigned i = 0; i < max_len; ++i) {
+        lang next;
+        for (std::string const& w : frontier) {
+            for (char const* c = alphabet; *c; ++c) {
+                next.insert(w + *c);
+            }
+        }
+        r.insert(next.begin(), next.end());
+        frontier = next;
+    }
+    return r;
+}
+
+static lang concat(lang const& a, lang const& b) {
+    lang r;
+    for (std::string const& u : a) {
+        for (std::string const& v : b) {
+            if (u.size() + v.size() <= max_len) {
+                r.insert(u + v);
+            }
+        }
+    }
+    return r;
+}
+
+// words of length at most max_len over the alphabet in the language of re.
+static lang ref_lang(seq_util& u, expr* re) {
+    expr *a = nullptr, *b = nullptr;
+    zstring s, t;
+    lang r;
+    if (u.re.is_to_re(re, a)) {
+        VERIFY(u.str.is_string(a, s));
+        r.insert(s.encode());
+    }
+    else if (u.re.is_union(re, a, b)) {
+        r = ref_lang(u, a);
+        lang rb = ref_lang(u, b);
+        r.insert(rb.begin(), rb.end());
+    }
+    else if (u.re.is_intersection(re, a, b)) {
+        lang ra = ref_lang(u, a), rb = ref_lang(u, b);
+        for (std::string const& w : ra) {
+            if (rb.count(w)) r.insert(w);
+        }
+    }
+    else if (u.re.is_complement(re, a)) {
+        lang ra = ref_lang(u, a);
+        for (std::string const& w : all_words()) {
+            if (!ra.count(w)) r.insert(w);
+        }
+    }
+    else if (u.re.is_concat(re, a, b)) {
+        r = concat(ref_lang(u, a), ref_lang(u, b));
+    }
+    else if (u.re.is_star(re, a) || u.re.is_plus(re, a)) {
+        lang ra = ref_lang(u, a);
+        lang next = ra;
+        r = ra;
+        for (unsigned i = 0; i < max_len; ++i) {
+            next = concat(next, ra);
+            r.insert(next.begin(), next.end());
+        }
+        if (u.re.is_star(re)) r.insert("");
+    }
+    else if (u.re.is_opt(re, a)) {
+        r = ref_lang(u, a);
+        r.insert("");
+    }
+    else if (u.re.is_range(re, a, b)) {
+        VERIFY(u.str.is_string(a, s) && u.str.is_string(b, t));
+        for (char const* c = alphabet; *c; ++c) {
+            if (s[0] <= (unsigned)*c && (unsigned)*c <= t[0]) r.insert(std::string(1, *c));
+        }
+    }
+    else if (u.re.is_full_char(re)) {
+        for (char const* c = alphabet; *c; ++c) r.insert(std::string(1, *c));
+    }
+    else if (u.re.is_full_seq(re)) {
+        r = all_words();
+    }
+    else {
+        ENSURE(u.re.is_empty(re));
+    }
+    return r;
+}
+
+static bool accepts(ast_manager& m, seq_util& u, eautomaton& a, std::string const& w) {
+    th_rewriter rw(m);
+    zstring zw(w.c_str());
+    unsigned_vector states;
+    a.get_epsilon_closure(a.init(), states);
+    for (unsigned i = 0; i < w.size(); ++i) {
+        expr_ref ch(u.str.mk_char(zw, i), m);
+        unsigned_vector next;
+        for (unsigned s : states) {
+            eautomaton::moves mvs;
+            a.get_moves_from(s, mvs, true);
+            for (auto const& mv : mvs) {
+                if (!mv.t()) continue;
+                expr_ref cond = mv.t()->accept(ch);
+                rw(cond);
+                ENSURE(m.is_true(cond) || m.is_false(cond));
+                if (m.is_true(cond)) {
+                    unsigned_vector cl;
+                    a.get_epsilon_closure(mv.dst(), cl);
+                    for (unsigned d : cl) {
+                        if (!next.contains(d)) next.push_back(d);
+                    }
+                }
+            }
+        }
+        states.swap(next);
+    }
+    for (unsigned s : states) {
+        if (a.is_final_state(s)) return true;
+    }
+    return false;
+}
+
+class kernel_expr_solver : public expr_solver {
+    smt_params m_params;
+    smt::kernel m_kernel;
+public:
+    kernel_expr_solver(ast_manager& m): m_kernel(m, m_params) {}
+    lbool check_sat(expr* e) override {
+        m_kernel.push();
+        m_kernel.assert_expr(e);
+        lbool r = m_kernel.check();
+        m_kernel.pop(1);
+        return r;
+    }
+};
+
+static void mk_regexes(seq_util& u, expr_ref_vector& res) {
+    ast_manager& m = res.get_manager();
+    auto str = [&](char const* s) { return u.re.mk_to_re(u.str.mk_string(symbol(s))); };
+    expr_ref a(str("a"), m), b(str("b"), m), c(str("c"), m), eps(str(""), m), ab(str("ab"), m);
+    expr_ref bc(u.re.mk_range(u.str.mk_string(symbol("b")), u.str.mk_string(symbol("c"))), m);
+    expr_ref any(u.re.mk_full_char(u.re.mk_re(u.str.mk_string_sort())), m);
+    res.push_back(u.re.mk_union(c, eps));
+    res.push_back(u.re.mk_star(u.re.mk_union(c, eps)));
+    res.push_back(u.re.mk_concat(u.re.mk_union(c, eps), u.re.mk_union(a, eps)));
+    res.push_back(u.re.mk_union(ab, u.re.mk_concat(a, u.re.mk_star(b))));
+    res.push_back(u.re.mk_plus(u.re.mk_union(ab, c)));
+    res.push_back(u.re.mk_concat(u.re.mk_star(a), u.re.mk_concat(bc, u.re.mk_opt(a))));
+    res.push_back(u.re.mk_union(u.re.mk_star(u.re.mk_concat(a, b)), u.re.mk_star(u.re.mk_concat(a, u.re.mk_concat(b, a)))));
+    res.push_back(u.re.mk_concat(any, u.re.mk_concat(a, any)));
+    res.push_back(u.re.mk_complement(u.re.mk_star(a)));
+    res.push_back(u.re.mk_inter(u.re.mk_star(u.re.mk_union(a, b)), u.re.mk_concat(u.re.mk_star(any), b)));
+    res.push_back(u.re.mk_complement(u.re.mk_union(eps, u.re.mk_concat(any, u.re.mk_star(c)))));
+}
+
+static void tst_automata() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    seq_util u(m);
+    re2automaton mk_aut(m);
+    mk_aut.set_solver(alloc(kernel_expr_solver, m));
+    expr_ref_vector res(m);
+    mk_regexes(u, res);
+
+    lang words = all_words();
+    for (expr* re : res) {
+        // the second translation is served from the cache
+        for (unsigned k = 0; k < 2; ++k) {
+            scoped_ptr<eautomaton> aut = mk_aut(re);
+            ENSURE(aut);
+            lang expected = ref_lang(u, re);
+            for (std::string const& w : words) {
+                bool acc = accepts(m, u, *aut, w);
+                if (acc != (expected.count(w) > 0)) {
+                    std::cout << mk_pp(re, m) << " on \"" << w << "\" accepts: " << acc << "\n";
+                }
+                ENSURE(acc == (expected.count(w) > 0));
+            }
+        }
+    }
+}
+
+static void tst_derivatives() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    seq_util u(m);
+    seq_rewriter rw(m);
+    expr_ref_vector res(m);
+    mk_regexes(u, res);
+
+    lang words = all_words();
+    // enough rounds to flush the derivative cache several times
+    for (unsigned k = 0; k < 8; ++k) {
+        for (expr* re : res) {
+            lang expected = ref_lang(u, re);
+            for (std::string const& w : words) {
+                expr_ref d(re, m);
+                for (char c : w) {
+                    ENSURE(rw.mk_re_derivative(c, d, d));
+                }
+                lbool n = rw.is_re_nullable(d);
+                ENSURE(n != l_undef);
+                ENSURE((n == l_true) == (expected.count(w) > 0));
+            }
+        }
+        // fresh regular expressions, so the cache keeps growing
+        expr_ref s(u.re.mk_to_re(u.str.mk_string(zstring(std::to_string(k).c_str()))), m);
+        for (unsigned i = 0; i < 1000; ++i) {
+            expr_ref r(u.re.mk_loop(s, i), m), d(m);
+            ENSURE(rw.mk_re_derivative('0' + k, r, d));
+            ENSURE(rw.is_re_nullable(d) == (i <= 1 ? l_true : l_false));
+        }
+    }
+}
+
+static void tst_in_re(char const* script, char const* expected) {
+    Z3_context ctx = Z3_mk_context(nullptr);
+    std::string result = Z3_eval_smtlib2_string(ctx, script);
+    std::cout << result;
+    Z3_del_context(ctx);
+    ENSURE(result == expected);
+}
+
+void tst_seq_rewriter() {
+    tst_automata();
+    tst_derivatives();
+    tst_in_re("(declare-const x String)\n"
+              "(assert (str.in.re x (re.union (str.to.re \"c\") (str.to.re \"\"))))\n"
+              "(assert (= (str.len x) 2))\n"
+              "(check-sat)\n", "unsat\n");
+    tst_in_re("(declare-const x String)\n"
+              "(assert (str.in.re x (re.* (re.union (str.to.re \"c\") (str.to.re \"\")))))\n"
+              "(assert (= (str.len x) 2))\n"
+              "(assert (not (= x \"cc\")))\n"
+              "(check-sat)\n", "unsat\n");
+    tst_in_re("(declare-const x String)\n"
+              "(assert (str.in.re x (re.++ (re.union (str.to.re \"c\") (str.to.re \"\")) (re.union (str.to.re \"a\") (str.to.re \"\")))))\n"
+              "(assert (= (str.len x) 2))\n"
+              "(check-sat)\n(get-value (x))\n", "sat\n((x \"ca\"))\n");
+}
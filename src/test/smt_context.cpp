@@ -6,6 +6,7 @@ Copyright (c) 2015 Microsoft Corporation
 
 #include "smt/smt_context.h"
 #include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
 
 void tst_smt_context()
 {
@@ -33,3 +34,46 @@ void tst_smt_context()
 
     ctx.check();
 }
+
+static void tst_core_cache(unsigned cache_size) {
+    smt_params params;
+    params.m_core_cache_size = cache_size;
+
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+
+    smt::context ctx(m, params);
+
+    app_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    app_ref p(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    app_ref q(m.mk_const(symbol("q"), m.mk_bool_sort()), m);
+    app_ref r(m.mk_const(symbol("r"), m.mk_bool_sort()), m);
+    ctx.assert_expr(m.mk_implies(p, a.mk_ge(x, a.mk_int(10))));
+    ctx.assert_expr(m.mk_implies(q, a.mk_le(x, a.mk_int(5))));
+
+    expr * pq[2]  = { p, q };
+    expr * pqr[3] = { r, q, p };
+    VERIFY(ctx.check(2, pq) == l_false);
+    VERIFY(ctx.get_unsat_core_size() == 2);
+    VERIFY(ctx.check(3, pqr) == l_false);
+    VERIFY(ctx.get_unsat_core_size() == 2);
+    VERIFY(ctx.m_stats.m_num_cached_cores == (cache_size > 0 ? 1u : 0u));
+    VERIFY(ctx.check(1, pqr) == l_true);
+
+    // cached cores are discarded on pop
+    ctx.push();
+    ctx.assert_expr(m.mk_not(r));
+    VERIFY(ctx.check(1, pqr) == l_false);
+    VERIFY(ctx.get_unsat_core_size() == 1);
+    ctx.pop(1);
+    VERIFY(ctx.check(1, pqr) == l_true);
+    VERIFY(ctx.check(2, pq) == l_false);
+    VERIFY(ctx.check(0, pq) == l_true);
+}
+
+void tst_smt_context_core_cache()
+{
+    tst_core_cache(0);
+    tst_core_cache(4);
+}
@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    theory_str.cpp
+
+Abstract:
+
+    Test the Z3str3 string solver on concat equalities whose arrangements
+    are generated again after backtracking and across user scopes.
+
+Revision History:
+
+--*/
+#include<iostream>
+#include<string>
+#include "api/z3.h"
+#include "util/debug.h"
+
+static void tst_str_script(char const * script, char const * expected, bool length_presolve = false) {
+    Z3_global_param_set("smt.string_solver", "z3str3");
+    Z3_global_param_set("smt.str.length_presolve", length_presolve ? "true" : "false");
+    Z3_context ctx = Z3_mk_context(nullptr);
+    std::string result = Z3_eval_smtlib2_string(ctx, script);
+    std::cout << result;
+    Z3_del_context(ctx);
+    Z3_global_param_reset_all();
+    ENSURE(result == expected);
+}
+
+void tst_theory_str() {
+    char const * decls =
+        "(declare-const x String)(declare-const y String)(declare-const z String)(declare-const w String)\n";
+    char const * sat_eqs =
+        "(assert (= (str.++ x x z) (str.++ x y)))\n"
+        "(assert (= (str.++ w y w) (str.++ \"ba\" y x)))\n"
+        "(assert (= (str.len z) 3))\n"
+        "(assert (> (str.len y) 2))\n";
+    char const * unsat_eqs =
+        "(assert (= (str.++ w z w) (str.++ x \"bb\")))\n"
+        "(assert (= (str.++ \"a\" w) (str.++ z \"a\")))\n"
+        "(assert (> (str.len z) 3))\n";
+
+    tst_str_script((std::string(decls) + sat_eqs + "(check-sat)\n").c_str(), "sat\n");
+    tst_str_script((std::string(decls) + unsat_eqs + "(check-sat)\n").c_str(), "unsat\n");
+
+    std::string script(decls);
+    for (unsigned i = 0; i < 3; ++i) {
+        script += std::string("(push)\n") + sat_eqs + "(check-sat)\n(pop)\n";
+        script += std::string("(push)\n") + unsat_eqs + "(check-sat)\n(pop)\n";
+    }
+    script += "(assert (= (str.++ w z w) (str.++ x \"bb\")))\n(check-sat)\n";
+    tst_str_script(script.c_str(), "sat\nunsat\nsat\nunsat\nsat\nunsat\nsat\n");
+    tst_str_script(script.c_str(), "sat\nunsat\nsat\nunsat\nsat\nunsat\nsat\n", true);
+
+    // unsatisfiable by the lengths of the strings
+    char const * len_unsat =
+        "(assert (= (str.++ x \"ab\" y) (str.++ z z)))\n"
+        "(assert (= (str.len z) (+ (str.len x) 1)))\n"
+        "(assert (= (str.len y) (+ (str.len x) 1)))\n";
+    tst_str_script((std::string(decls) + len_unsat + "(check-sat)\n").c_str(), "unsat\n", true);
+    tst_str_script((std::string(decls) + "(push)\n" + len_unsat + "(check-sat)\n(pop)\n" + sat_eqs + "(check-sat)\n").c_str(), 
+                   "unsat\nsat\n", true);
+}
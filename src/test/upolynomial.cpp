@@ -953,6 +953,8 @@ static void tst_fact() {
                  - 47, 1);
 
     tst_fact( (x0^4) - 404*(x0^2) + 39204, 2);
+    // Swinnerton-Dyer polynomial for sqrt(2), sqrt(3), sqrt(5), sqrt(7): irreducible, but it has 8 quadratic factors modulo every prime
+    tst_fact( (x0^16) - 136*(x0^14) + 6476*(x0^12) - 141912*(x0^10) + 1513334*(x0^8) - 7453176*(x0^6) + 13950764*(x0^4) - 5596840*(x0^2) + 46225, 1);
     tst_fact( ((x0^5) - 15552)*
               ((x0^20)- 15708*(x0^15) + rational("138771724")*(x0^10)- rational("432104148432")*(x0^5) + rational("614198284585616")),
               2);
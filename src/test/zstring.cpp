@@ -0,0 +1,122 @@
+/*++
+Copyright (c) 2018 Microsoft Corporation
+
+Module Name:
+
+    zstring.cpp
+
+Abstract:
+
+    Test zstring and the string constants of seq_decl_plugin.
+
+Revision History:
+
+--*/
+#include "ast/seq_decl_plugin.h"
+#include "ast/reg_decl_plugins.h"
+
+static void tst_slices() {
+    zstring s("abcabcab");
+    ENSURE(s.length() == 8);
+    zstring a = s.extract(0, 3);
+    zstring b = s.extract(3, 3);
+    zstring c("abc");
+    ENSURE(a == b);
+    ENSURE(a == c);
+    ENSURE(a.hash() == c.hash());
+    ENSURE(b.hash() == c.hash());
+    ENSURE(s.extract(6, 10) == zstring("ab"));
+    ENSURE(s.extract(8, 2).empty());
+    ENSURE(s.extract(2, 0).empty());
+    ENSURE(s.extract(1, 2) != s.extract(2, 2));
+
+    // slices of slices
+    zstring d = s.extract(2, 5).extract(1, 3);
+    ENSURE(d == zstring("abc"));
+    ENSURE(d.hash() == c.hash());
+
+    // the buffer outlives the string it was sliced from
+    zstring e;
+    {
+        zstring t("0123456789");
+        e = t.extract(7, 3);
+    }
+    ENSURE(e == zstring("789"));
+
+    ENSURE(a + b == zstring("abcabc"));
+    ENSURE(a + zstring() == a);
+    ENSURE(zstring() + a == a);
+    ENSURE(s.extract(0, 6) == a + b);
+}
+
+static void tst_operations() {
+    zstring s("hello world");
+    ENSURE(zstring("hello").prefixof(s));
+    ENSURE(!zstring("world").prefixof(s));
+    ENSURE(zstring("world").suffixof(s));
+    ENSURE(s.contains(zstring("o w")));
+    ENSURE(!s.contains(zstring("ow")));
+    ENSURE(s.indexof(zstring("o"), 0) == 4);
+    ENSURE(s.indexof(zstring("o"), 5) == 7);
+    ENSURE(s.indexof(zstring("x"), 0) == -1);
+    ENSURE(s.replace(zstring("o"), zstring("0")) == zstring("hell0 world"));
+    ENSURE(s.replace(zstring("x"), zstring("0")) == s);
+    ENSURE(s.extract(6, 5).replace(zstring("wor"), zstring("")) == zstring("ld"));
+    ENSURE(zstring("ab") < zstring("b"));
+    ENSURE(zstring("a") < zstring("ab"));
+    ENSURE(!(zstring("ab") < zstring("ab")));
+}
+
+static void tst_encode() {
+    unsigned chars[6] = { 'a', '\\', 0, 10, 200, 'x' };
+    zstring s(6, chars);
+    zstring t(s.encode().c_str());
+    ENSURE(s == t);
+    ENSURE(s.hash() == t.hash());
+    zstring u("\\x41\\n\\\\");
+    ENSURE(u.length() == 3);
+    ENSURE(u[0] == 'A' && u[1] == '\n' && u[2] == '\\');
+}
+
+static void tst_constants() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    seq_util u(m);
+    zstring s("abcabc");
+    expr_ref a(u.str.mk_string(s.extract(0, 3)), m);
+    expr_ref b(u.str.mk_string(s.extract(3, 3)), m);
+    expr_ref c(u.str.mk_string(zstring("abc")), m);
+    expr_ref d(u.str.mk_string(symbol("abc")), m);
+    ENSURE(a == b && b == c && c == d);
+    expr_ref e(u.str.mk_string(s.extract(1, 3)), m);
+    ENSURE(a != e);
+
+    // constants round trip through their symbols, whichever way they were created
+    unsigned chars[4] = { '\\', 'x', '4', '1' };
+    zstring bs(4, chars);
+    expr_ref f(u.str.mk_string(bs), m);
+    expr_ref g(u.str.mk_string(symbol("\\x41")), m);
+    expr_ref h(u.str.mk_string(zstring("A")), m);
+    ENSURE(f != h);
+    zstring r;
+    ENSURE(u.str.is_string(f, r) && r == bs);
+    ENSURE(u.str.is_string(g, r) && r == zstring("A"));
+    ENSURE(u.str.is_string(h, r) && r == zstring("A"));
+    ENSURE(u.str.is_string(e, r) && r == zstring("bca"));
+
+    // more constants than a cache generation holds
+    for (unsigned i = 0; i < 70000; ++i) {
+        unsigned ch[4] = { 'a' + i % 26, 'a' + (i / 26) % 26, 'a' + (i / 676) % 26, 'a' + i / 17576 };
+        zstring z(4, ch);
+        expr_ref k(u.str.mk_string(z), m);
+        ENSURE(u.str.is_string(k, r) && r == z);
+    }
+    ENSURE(u.str.is_string(a, r) && r == zstring("abc"));
+}
+
+void tst_zstring() {
+    tst_slices();
+    tst_operations();
+    tst_encode();
+    tst_constants();
+}
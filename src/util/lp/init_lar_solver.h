@@ -24,7 +24,7 @@ bool strategy_is_undecided() const {
     return m_settings.simplex_strategy() == simplex_strategy_enum::undecided;
 }
 
-var_index add_var(unsigned ext_j) {
+var_index add_var(unsigned ext_j, bool is_int = false) {
     var_index i;
     SASSERT (ext_j < m_terms_start_index); 
 
@@ -37,25 +37,26 @@ var_index add_var(unsigned ext_j) {
     SASSERT(m_vars_to_ul_pairs.size() == A_r().column_count());
     i = A_r().column_count();
     m_vars_to_ul_pairs.push_back (ul_pair(static_cast<unsigned>(-1)));
-    add_non_basic_var_to_core_fields(ext_j);
+    add_non_basic_var_to_core_fields(ext_j, is_int);
     SASSERT(sizes_are_correct());
     return i;
 }
 
-void register_new_ext_var_index(unsigned ext_v) {
+void register_new_ext_var_index(unsigned ext_v, bool is_int) {
     SASSERT(!contains(m_ext_vars_to_columns, ext_v));
     unsigned j = static_cast<unsigned>(m_ext_vars_to_columns.size());
     m_ext_vars_to_columns[ext_v] = j;
     SASSERT(m_columns_to_ext_vars_or_term_indices.size() == j);
     m_columns_to_ext_vars_or_term_indices.push_back(ext_v);
+    m_column_is_int.push_back(is_int);
 }
 
-void add_non_basic_var_to_core_fields(unsigned ext_j) {
-    register_new_ext_var_index(ext_j);
+void add_non_basic_var_to_core_fields(unsigned ext_j, bool is_int) {
+    register_new_ext_var_index(ext_j, is_int);
     m_mpq_lar_core_solver.m_column_types.push_back(column_type::free_column);
     m_columns_with_changed_bound.increase_size_by_one();
     add_new_var_to_core_fields_for_mpq(false);
-    if (use_lu())
+    if (m_mpq_lar_core_solver.need_to_presolve_with_double_solver())
         add_new_var_to_core_fields_for_doubles(false);
 }
 
@@ -135,8 +136,18 @@ void add_row_for_term(const lar_term * term, unsigned term_ext_index) {
     SASSERT(sizes_are_correct());
 }
 
+// a term column is integral when the term has integral coefficients over integral columns
+bool term_is_int(const lar_term * term) const {
+    if (!term->m_v.is_int())
+        return false;
+    for (auto const& p : term->m_coeffs)
+        if (!p.second.is_int() || p.first >= m_column_is_int.size() || !column_is_int(p.first))
+            return false;
+    return true;
+}
+
 void add_row_from_term_no_constraint(const lar_term * term, unsigned term_ext_index) {
-    register_new_ext_var_index(term_ext_index);
+    register_new_ext_var_index(term_ext_index, term_is_int(term));
     // j will be a new variable
     unsigned j = A_r().column_count();
     ul_pair ul(j);
@@ -151,7 +162,7 @@ void add_row_from_term_no_constraint(const lar_term * term, unsigned term_ext_in
         fill_last_row_of_A_r(A_r(), term);
     }
     m_mpq_lar_core_solver.m_r_x[j] = get_basic_var_value_from_row_directly(A_r().row_count() - 1);
-    if (use_lu())
+    if (m_mpq_lar_core_solver.need_to_presolve_with_double_solver())
         fill_last_row_of_A_d(A_d(), term);
 }
 
@@ -288,7 +299,7 @@ void adjust_initial_state_for_tableau_rows() {
     }
 }
 
-// this fills the last row of A_d and sets the basis column: -1 in the last column of the row
+// this fills the last row of A_d and sets the basis column: 1 in the last column of the row, as in fill_last_row_of_A_r
 void fill_last_row_of_A_d(static_matrix<double, double> & A, const lar_term* ls) {
     SASSERT(A.row_count() > 0);
     SASSERT(A.column_count() > 0);
@@ -302,7 +313,7 @@ void fill_last_row_of_A_d(static_matrix<double, double> & A, const lar_term* ls)
     }
 
     unsigned basis_j = A.column_count() - 1;
-    A.set(last_row, basis_j, - 1 );
+    A.set(last_row, basis_j, 1);
 }
 
 void update_free_column_type_and_bound(var_index j, lconstraint_kind kind, const mpq & right_side, constraint_index constr_ind) {
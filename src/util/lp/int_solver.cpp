@@ -0,0 +1,400 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    int_solver.cpp
+
+Abstract:
+
+    Integer reasoning on top of lar_solver.
+
+Revision History:
+
+
+--*/
+#include "util/lp/lar_solver.h"
+#include "util/lp/int_solver.h"
+namespace lp {
+
+static bool is_int_value(const impq & v) {
+    return v.x.is_int() && v.y.is_zero();
+}
+
+// the largest integer that is not greater than v
+static mpq floor(const impq & v) {
+    if (v.x.is_int())
+        return v.y.is_neg() ? v.x - one_of_type<mpq>() : v.x;
+    return floor(v.x);
+}
+
+static mpq frac(const mpq & a) {
+    return a - floor(a);
+}
+
+int_solver::int_solver(lar_solver & ls):
+    m_lar_solver(ls),
+    m_check_counter(0) {}
+
+bool int_solver::column_is_int(unsigned j) const {
+    return m_lar_solver.column_is_int(j);
+}
+
+bool int_solver::column_is_int_inf(unsigned j) const {
+    return column_is_int(j) && !is_int_value(get_value(j));
+}
+
+bool int_solver::is_base(unsigned j) const {
+    return m_lar_solver.m_mpq_lar_core_solver.m_r_heading[j] >= 0;
+}
+
+bool int_solver::is_fixed(unsigned j) const {
+    return m_lar_solver.m_mpq_lar_core_solver.m_column_types()[j] == column_type::fixed;
+}
+
+bool int_solver::is_boxed(unsigned j) const {
+    column_type t = m_lar_solver.m_mpq_lar_core_solver.m_column_types()[j];
+    return t == column_type::boxed || t == column_type::fixed;
+}
+
+bool int_solver::has_low(unsigned j) const {
+    column_type t = m_lar_solver.m_mpq_lar_core_solver.m_column_types()[j];
+    return t == column_type::low_bound || t == column_type::boxed || t == column_type::fixed;
+}
+
+bool int_solver::has_upper(unsigned j) const {
+    column_type t = m_lar_solver.m_mpq_lar_core_solver.m_column_types()[j];
+    return t == column_type::upper_bound || t == column_type::boxed || t == column_type::fixed;
+}
+
+bool int_solver::at_low(unsigned j) const {
+    return has_low(j) && get_value(j) == low_bound(j);
+}
+
+bool int_solver::at_upper(unsigned j) const {
+    return has_upper(j) && get_value(j) == upper_bound(j);
+}
+
+const impq & int_solver::get_value(unsigned j) const {
+    return m_lar_solver.m_mpq_lar_core_solver.m_r_x[j];
+}
+
+const impq & int_solver::low_bound(unsigned j) const {
+    return m_lar_solver.m_mpq_lar_core_solver.m_r_low_bounds()[j];
+}
+
+const impq & int_solver::upper_bound(unsigned j) const {
+    return m_lar_solver.m_mpq_lar_core_solver.m_r_upper_bounds()[j];
+}
+
+bool int_solver::value_is_within_bounds(unsigned j, const impq & v) const {
+    if (has_low(j) && v < low_bound(j))
+        return false;
+    if (has_upper(j) && v > upper_bound(j))
+        return false;
+    return true;
+}
+
+bool int_solver::has_inf_int() const {
+    unsigned n = m_lar_solver.A_r().column_count();
+    for (unsigned j = 0; j < n; j++)
+        if (column_is_int_inf(j))
+            return true;
+    return false;
+}
+
+/*
+  Move the value of a non-basic integer column to floor or ceil of its value
+  when the basic columns depending on it stay within their bounds and the
+  integral basic columns stay integral.
+*/
+void int_solver::patch_int_columns() {
+    auto & core = m_lar_solver.m_mpq_lar_core_solver;
+    for (unsigned j : core.m_r_nbasis) {
+        if (!column_is_int_inf(j))
+            continue;
+        const impq & v = get_value(j);
+        impq lo(floor(v));
+        if (try_patch_column(j, lo))
+            continue;
+        try_patch_column(j, lo + impq(one_of_type<mpq>()));
+    }
+}
+
+bool int_solver::try_patch_column(unsigned j, const impq & v) {
+    auto & core = m_lar_solver.m_mpq_lar_core_solver;
+    if (!value_is_within_bounds(j, v))
+        return false;
+    impq delta = v - get_value(j);
+    for (const auto & c : m_lar_solver.A_r().m_columns[j]) {
+        unsigned bj = core.m_r_basis[c.m_i];
+        impq nv = get_value(bj) - m_lar_solver.A_r().get_val(c) * delta;
+        if (!value_is_within_bounds(bj, nv))
+            return false;
+        if (column_is_int(bj) && !column_is_int_inf(bj) && !is_int_value(nv))
+            return false;
+    }
+    core.m_r_x[j] = v;
+    m_lar_solver.change_basic_x_by_delta_on_column(j, delta);
+    core.m_r_solver.update_column_in_inf_set(j);
+    return true;
+}
+
+void int_solver::add_fixed_explanation(unsigned j, lia_explanation & ex) const {
+    const ul_pair & ul = m_lar_solver.m_vars_to_ul_pairs[j];
+    ex.push_back(std::make_pair(one_of_type<mpq>(), ul.low_bound_witness()));
+    ex.push_back(std::make_pair(one_of_type<mpq>(), ul.upper_bound_witness()));
+}
+
+bool int_solver::gcd_test(lia_explanation & ex) {
+    unsigned m = m_lar_solver.A_r().row_count();
+    for (unsigned i = 0; i < m; i++)
+        if (!gcd_test_for_row(i, ex))
+            return false;
+    return true;
+}
+
+/*
+  A row  sum a_j x_j = 0  over integer columns has no integral solution
+  if the gcd of the coefficients of the non-fixed columns does not divide
+  the sum of the fixed part. The coefficients are scaled by the lcm of
+  their denominators first.
+*/
+bool int_solver::gcd_test_for_row(unsigned i, lia_explanation & ex) {
+    const auto & row = m_lar_solver.A_r().m_rows[i];
+    mpq lcm_den = one_of_type<mpq>();
+    for (const auto & c : row) {
+        if (!column_is_int(c.m_j))
+            return true;
+        lcm_den = lcm(lcm_den, denominator(c.get_val()));
+    }
+    mpq consts = zero_of_type<mpq>();
+    mpq gcds = zero_of_type<mpq>();
+    mpq least_coeff = zero_of_type<mpq>();
+    bool least_coeff_is_bounded = false;
+    for (const auto & c : row) {
+        unsigned j = c.m_j;
+        mpq a = lcm_den * c.get_val();
+        if (is_fixed(j)) {
+            const impq & l = low_bound(j);
+            if (!is_int_value(l))
+                return true;
+            consts += a * l.x;
+            continue;
+        }
+        mpq abs_a = abs(a);
+        bool bounded = is_boxed(j) && is_int_value(low_bound(j)) && is_int_value(upper_bound(j));
+        if (gcds.is_zero()) {
+            gcds = abs_a;
+            least_coeff = abs_a;
+            least_coeff_is_bounded = bounded;
+        }
+        else {
+            gcds = gcd(gcds, abs_a);
+            if (abs_a < least_coeff) {
+                least_coeff = abs_a;
+                least_coeff_is_bounded = bounded;
+            }
+            else if (abs_a == least_coeff) {
+                least_coeff_is_bounded &= bounded;
+            }
+        }
+    }
+    if (gcds.is_zero())
+        return true;
+    if (!(consts / gcds).is_int()) {
+        for (const auto & c : row)
+            if (is_fixed(c.m_j))
+                add_fixed_explanation(c.m_j, ex);
+        return false;
+    }
+    if (least_coeff_is_bounded)
+        return ext_gcd_test(i, least_coeff, lcm_den, consts, ex);
+    return true;
+}
+
+/*
+  The columns with the least coefficient are bounded. Their contribution
+  ranges in [l, u], and the remaining non-fixed columns contribute a
+  multiple of the gcd of their coefficients. The row is infeasible if
+  there is no such multiple in [l, u].
+*/
+bool int_solver::ext_gcd_test(unsigned i, const mpq & least_coeff, const mpq & lcm_den, const mpq & consts, lia_explanation & ex) {
+    const auto & row = m_lar_solver.A_r().m_rows[i];
+    mpq gcds = zero_of_type<mpq>();
+    mpq l(consts);
+    mpq u(consts);
+    for (const auto & c : row) {
+        unsigned j = c.m_j;
+        if (is_fixed(j))
+            continue;
+        mpq a = lcm_den * c.get_val();
+        mpq abs_a = abs(a);
+        if (abs_a == least_coeff) {
+            if (a.is_pos()) {
+                l += a * low_bound(j).x;
+                u += a * upper_bound(j).x;
+            }
+            else {
+                l += a * upper_bound(j).x;
+                u += a * low_bound(j).x;
+            }
+        }
+        else if (gcds.is_zero()) {
+            gcds = abs_a;
+        }
+        else {
+            gcds = gcd(gcds, abs_a);
+        }
+    }
+    if (gcds.is_zero())
+        return true;
+    if (floor(u / gcds) < ceil(l / gcds)) {
+        for (const auto & c : row) {
+            unsigned j = c.m_j;
+            if (is_fixed(j) || abs(lcm_den * c.get_val()) == least_coeff)
+                add_fixed_explanation(j, ex);
+        }
+        return false;
+    }
+    return true;
+}
+
+/*
+  Gomory mixed integer cut on the row of the basic column j.
+  The row is  x_j + sum_k a_k x_k = 0. Each non-basic x_k is at a bound;
+  substituting x_k = l_k + y_k or x_k = u_k - y_k gives
+  x_j + sum_k a'_k y_k = x_j's value with y_k >= 0, and the cut
+  sum_k g_k y_k >= 1 is expressed back in terms of the x_k.
+*/
+bool int_solver::mk_gomory_cut(unsigned j, lar_term & t, mpq & k, lia_explanation & ex) {
+    auto & core = m_lar_solver.m_mpq_lar_core_solver;
+    const impq & v = get_value(j);
+    if (!v.y.is_zero())
+        return false;
+    mpq f0 = frac(v.x);
+    if (f0.is_zero())
+        return false;
+    mpq one_minus_f0 = one_of_type<mpq>() - f0;
+    const auto & row = m_lar_solver.A_r().m_rows[core.m_r_heading[j]];
+    mpq a_j;
+    for (const auto & c : row)
+        if (c.m_j == j)
+            a_j = c.get_val();
+    SASSERT(!a_j.is_zero());
+    t.m_coeffs.clear();
+    t.m_v = zero_of_type<mpq>();
+    k = one_of_type<mpq>();
+    lia_explanation cut_ex;
+    bool all_int = true;
+    for (const auto & c : row) {
+        unsigned x = c.m_j;
+        if (x == j)
+            continue;
+        bool lower = at_low(x);
+        if (!lower && !at_upper(x))
+            return false;
+        const impq & b = lower ? low_bound(x) : upper_bound(x);
+        if (!b.y.is_zero())
+            return false;
+        mpq a = c.get_val() / a_j;
+        if (!lower)
+            a.neg();
+        mpq g;
+        if (column_is_int(x) && b.x.is_int()) {
+            mpq f = frac(a);
+            if (f.is_zero())
+                continue;
+            g = f <= f0 ? f / f0 : (one_of_type<mpq>() - f) / one_minus_f0;
+        }
+        else {
+            all_int = false;
+            if (a.is_zero())
+                continue;
+            g = a.is_pos() ? a / f0 : -a / one_minus_f0;
+        }
+        const ul_pair & ul = m_lar_solver.m_vars_to_ul_pairs[x];
+        constraint_index ci = lower ? ul.low_bound_witness() : ul.upper_bound_witness();
+        if (ci == static_cast<constraint_index>(-1))
+            return false;
+        cut_ex.push_back(std::make_pair(one_of_type<mpq>(), ci));
+        if (lower) {
+            t.add_to_map(x, g);
+            k += g * b.x;
+        }
+        else {
+            t.add_to_map(x, -g);
+            k -= g * b.x;
+        }
+    }
+    if (t.m_coeffs.empty())
+        return false;
+    if (all_int) {
+        mpq l = denominator(k);
+        for (const auto & p : t.m_coeffs)
+            l = lcm(l, denominator(p.second));
+        for (auto & p : t.m_coeffs)
+            p.second *= l;
+        k = ceil(k * l);
+    }
+    for (const auto & e : cut_ex)
+        ex.push_back(e);
+    return true;
+}
+
+unsigned int_solver::find_inf_int_base_column() {
+    auto & core = m_lar_solver.m_mpq_lar_core_solver;
+    unsigned result = static_cast<unsigned>(-1);
+    unsigned n = 0;
+    for (unsigned j : core.m_r_basis) {
+        if (!column_is_int_inf(j))
+            continue;
+        if (m_lar_solver.settings().random_next() % (++n) == 0)
+            result = j;
+    }
+    return result;
+}
+
+unsigned int_solver::find_inf_int_column() {
+    unsigned j = find_inf_int_base_column();
+    if (j != static_cast<unsigned>(-1))
+        return j;
+    unsigned n = m_lar_solver.A_r().column_count();
+    for (j = 0; j < n; j++)
+        if (column_is_int_inf(j))
+            return j;
+    return static_cast<unsigned>(-1);
+}
+
+lia_move int_solver::check(lar_term & t, mpq & k, lia_explanation & ex) {
+    if (!has_inf_int())
+        return lia_move::ok;
+    bool tableau = m_lar_solver.settings().use_tableau();
+    if (tableau) {
+        patch_int_columns();
+        if (!has_inf_int())
+            return lia_move::ok;
+        if (!gcd_test(ex))
+            return lia_move::conflict;
+    }
+    unsigned ratio = m_lar_solver.settings().m_int_branch_cut_ratio;
+    if (tableau && ratio > 0 && (++m_check_counter) % ratio == 0) {
+        unsigned j = find_inf_int_base_column();
+        if (j != static_cast<unsigned>(-1) && mk_gomory_cut(j, t, k, ex)) {
+            return lia_move::cut;
+        }
+    }
+    return branch(t, k);
+}
+
+lia_move int_solver::branch(lar_term & t, mpq & k) {
+    unsigned j = find_inf_int_column();
+    if (j == static_cast<unsigned>(-1))
+        return lia_move::give_up;
+    t.m_coeffs.clear();
+    t.m_v = zero_of_type<mpq>();
+    t.add_to_map(j, one_of_type<mpq>());
+    k = floor(get_value(j));
+    return lia_move::branch;
+}
+}
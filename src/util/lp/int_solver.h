@@ -0,0 +1,74 @@
+/*++
+Copyright (c) 2017 Microsoft Corporation
+
+Module Name:
+
+    int_solver.h
+
+Abstract:
+
+    Integer reasoning on top of lar_solver.
+
+    The solver is called after lar_solver has found a feasible solution
+    of the LP relaxation. It tries, in this order,
+    - to patch the non-basic integer columns with fractional values,
+    - the GCD test and the extended GCD test on the rows of the tableau,
+    - a Gomory mixed integer cut, on every m_int_branch_cut_ratio-th call,
+    - a branch on an integer column with a fractional value.
+    Cuts and branches are returned to the caller as a term t and a bound k:
+    for a cut the new constraint is t >= k, for a branch the split is
+    t <= k or t >= k + 1.
+
+Revision History:
+
+
+--*/
+#pragma once
+#include "util/lp/lp_settings.h"
+#include "util/lp/lar_term.h"
+namespace lp {
+class lar_solver;
+
+enum class lia_move {
+    ok,
+    branch,
+    cut,
+    conflict,
+    give_up
+};
+
+typedef vector<std::pair<mpq, constraint_index>> lia_explanation;
+
+class int_solver {
+    lar_solver & m_lar_solver;
+    unsigned     m_check_counter;
+public:
+    int_solver(lar_solver & ls);
+    lia_move check(lar_term & t, mpq & k, lia_explanation & ex);
+    bool has_inf_int() const;
+    lia_move branch(lar_term & t, mpq & k);
+private:
+    bool column_is_int(unsigned j) const;
+    bool column_is_int_inf(unsigned j) const;
+    bool is_base(unsigned j) const;
+    bool is_fixed(unsigned j) const;
+    bool is_boxed(unsigned j) const;
+    bool has_low(unsigned j) const;
+    bool has_upper(unsigned j) const;
+    bool at_low(unsigned j) const;
+    bool at_upper(unsigned j) const;
+    const impq & get_value(unsigned j) const;
+    const impq & low_bound(unsigned j) const;
+    const impq & upper_bound(unsigned j) const;
+    bool value_is_within_bounds(unsigned j, const impq & v) const;
+    void patch_int_columns();
+    bool try_patch_column(unsigned j, const impq & v);
+    bool gcd_test(lia_explanation & ex);
+    bool gcd_test_for_row(unsigned i, lia_explanation & ex);
+    bool ext_gcd_test(unsigned i, const mpq & least_coeff, const mpq & lcm_den, const mpq & consts, lia_explanation & ex);
+    void add_fixed_explanation(unsigned j, lia_explanation & ex) const;
+    bool mk_gomory_cut(unsigned j, lar_term & t, mpq & k, lia_explanation & ex);
+    unsigned find_inf_int_base_column();
+    unsigned find_inf_int_column();
+};
+}
@@ -261,8 +261,13 @@ public:
         SASSERT(!need_to_presolve_with_double_solver() || m_d_solver.basis_heading_is_correct());
     }
 
+    // In the tableau_rows mode the double solver keeps the original rows in m_d_A and its own LU
+    // factorization. It finds a basis quickly, and the rational tableau is then pivoted to this
+    // basis and repaired exactly, see solve_on_signature_tableau(). The tableau_costs mode is
+    // not supported.
     bool need_to_presolve_with_double_solver() const {
-        return settings().simplex_strategy() == simplex_strategy_enum::lu;
+        return settings().simplex_strategy() == simplex_strategy_enum::lu ||
+            (settings().use_tableau_rows() && settings().presolve_with_double_solver_for_lar);
     }
 
     template <typename L>
@@ -724,7 +729,13 @@ public:
         extract_signature_from_lp_core_solver(m_r_solver, signature);
         prepare_solver_x_with_signature(signature, m_d_solver);
         m_d_solver.start_tracing_basis_changes();
-        m_d_solver.find_feasible_solution();
+        {
+            // the double solver always works on the LU factorization
+            simplex_strategy_enum s = settings().simplex_strategy();
+            settings().simplex_strategy() = simplex_strategy_enum::lu;
+            m_d_solver.find_feasible_solution();
+            settings().simplex_strategy() = s;
+        }
         if (settings().get_cancel_flag())
             return vector<unsigned>();
             
@@ -48,12 +48,14 @@ Revision History:
 namespace lp {
 
 class lar_solver : public column_namer {
+    friend class int_solver;
     //////////////////// fields //////////////////////////
     lp_settings                             m_settings;
     stacked_value<lp_status>                m_status;
     stacked_value<simplex_strategy_enum>    m_simplex_strategy;
     std::unordered_map<unsigned, var_index> m_ext_vars_to_columns;
     vector<unsigned>                        m_columns_to_ext_vars_or_term_indices;
+    vector<bool>                            m_column_is_int;
     stacked_vector<ul_pair>                 m_vars_to_ul_pairs;
     vector<lar_base_constraint*>            m_constraints;
     stacked_value<unsigned>                 m_constraint_count;
@@ -358,6 +360,12 @@ public:
         //        new linear_combination_iterator_on_vector<mpq>(m_terms[adjust_term_index(term_index)]->coeffs_as_vector());
     }
 
+    bool column_is_int(unsigned j) const { return m_column_is_int[j]; }
+
+    bool has_int_var() const {
+        return std::find(m_column_is_int.begin(), m_column_is_int.end(), true) != m_column_is_int.end();
+    }
+
     unsigned adjust_column_index_to_term_index(unsigned j) const {
         unsigned ext_var_or_term = m_columns_to_ext_vars_or_term_indices[j];
         return ext_var_or_term < m_terms_start_index ? j : ext_var_or_term;
@@ -409,18 +417,36 @@ public:
     }
 
 
-    // goes over touched rows and tries to induce bounds
+    // goes over touched rows and tries to induce bounds;
+    // the rows are taken in the order they were touched until the work budget is spent,
+    // the rest stays in m_rows_with_changed_bounds for the next call
     void propagate_bounds_for_touched_rows(lp_bound_propagator & bp) {
         if (!use_tableau())
             return;  // ! todo : enable bound propagaion here. The current bug is that after the pop
         // the changed terms become incorrect!
 
-        for (unsigned i : m_rows_with_changed_bounds.m_index) {
+        unsigned budget = settings().bound_propagation_budget;
+        unsigned work = 0;
+        unsigned k = 0;
+        const auto & rows = m_rows_with_changed_bounds.m_index;
+        for (; k < rows.size() && (budget == 0 || work < budget); k++) {
+            unsigned i = rows[k];
+            work += A_r().m_rows[i].size();
             calculate_implied_bounds_for_row(i, bp);
+            settings().st().m_num_of_rows_for_bound_propagation++;
             if (settings().get_cancel_flag())
                 return;
         }
-        m_rows_with_changed_bounds.clear();
+        if (k == rows.size()) {
+            m_rows_with_changed_bounds.clear();
+        } else {
+            vector<int> rest;
+            for (; k < rows.size(); k++)
+                rest.push_back(rows[k]);
+            m_rows_with_changed_bounds.clear();
+            for (unsigned i : rest)
+                m_rows_with_changed_bounds.insert(i);
+        }
         if (!use_tableau()) {
             propagate_bounds_on_terms(bp);
         }
@@ -507,6 +533,7 @@ public:
         for (unsigned j = n_was; j-- > n;)
             m_ext_vars_to_columns.erase(m_columns_to_ext_vars_or_term_indices[j]);
         m_columns_to_ext_vars_or_term_indices.resize(n);
+        m_column_is_int.resize(n);
         if (m_settings.use_tableau()) {
             pop_tableau();
         }
@@ -96,6 +96,7 @@ struct stats {
     unsigned m_num_factorizations;
     unsigned m_num_of_implied_bounds;
     unsigned m_need_to_solve_inf;
+    unsigned m_num_of_rows_for_bound_propagation;
     stats() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
 };
@@ -204,7 +205,7 @@ public:
                     primal_feasibility_tolerance ( 1e-7), // page 71 of the PhD thesis of Achim Koberstein
                     relative_primal_feasibility_tolerance ( 1e-9), // page 71 of the PhD thesis of Achim Koberstein
                     m_bound_propagation ( true),
-                    presolve_with_double_solver_for_lar(true),
+                    presolve_with_double_solver_for_lar(false),
                     m_simplex_strategy(simplex_strategy_enum::tableau_rows),
                     report_frequency(1000),
                     print_statistics(false),
@@ -213,8 +214,10 @@ public:
                     density_threshold(0.7),
                     use_breakpoints_in_feasibility_search(false),
                     max_row_length_for_bound_propagation(300),
+                    bound_propagation_budget(20000),
                     backup_costs(true),
-                    column_number_threshold_for_using_lu_in_lar_solver(4000)
+                    column_number_threshold_for_using_lu_in_lar_solver(4000),
+                    m_int_branch_cut_ratio(2)
     {}
 
     void set_resource_limit(lp_resource_limit& lim) { m_resource_limit = &lim; }
@@ -319,8 +322,12 @@ public:
     unsigned random_next() { return m_rand(); }
     void random_seed(unsigned s) { m_rand.set_seed(s); }
     unsigned max_row_length_for_bound_propagation;
+    // the number of row cells analyzed in one round of bound propagation, 0 means no limit;
+    // the rows that do not fit stay queued for the next round
+    unsigned bound_propagation_budget;
     bool backup_costs;
     unsigned column_number_threshold_for_using_lu_in_lar_solver;
+    unsigned m_int_branch_cut_ratio; // every m_int_branch_cut_ratio-th integer check tries a Gomory cut before branching
 }; // end of lp_settings class
 
 
@@ -70,6 +70,8 @@ public:
     // if the column is not present then m_work_pivot_vector[j] is -1
     vector<int>                       m_work_pivot_vector;
     vector<bool>                      m_processed;
+    // the stack of the depth first search building the order of a hypersparse solve
+    vector<std::pair<unsigned, unsigned>> m_dfs_stack;
     unsigned get_n_of_active_elems() const { return m_n_of_active_elems; }
 
 #ifdef Z3DEBUG
@@ -403,9 +405,9 @@ public:
     void check_matrix();
 #endif
     void create_graph_G(const vector<unsigned> & active_rows, vector<unsigned> & sorted_active_rows);
-    void process_column_recursively(unsigned i, vector<unsigned>  & sorted_rows);    
+    void process_column_in_dfs(unsigned i, vector<unsigned>  & sorted_rows);
     void extend_and_sort_active_rows(const vector<unsigned> & active_rows, vector<unsigned> & sorted_active_rows);
-    void process_index_recursively_for_y_U(unsigned j, vector<unsigned>  & sorted_rows);
+    void process_index_in_dfs_for_y_U(unsigned j, vector<unsigned>  & sorted_rows);
     void resize(unsigned new_dim) {
         unsigned old_dim = dimension();
         SASSERT(new_dim >= old_dim);
@@ -617,34 +617,64 @@ void sparse_matrix<T, X>::solve_U_y(vector<L> & y) { // it is a column wise vers
     // SASSERT(vectors_are_equal(rs, clone_y, dimension()));
 #endif
 }
+// The depth first searches below use the explicit stack m_dfs_stack instead of recursion:
+// a chain of dependencies in U can be as long as the dimension of the matrix.
+// An entry of the stack is a vertex and the position of the next edge to explore.
 template <typename T, typename X>
-void sparse_matrix<T, X>::process_index_recursively_for_y_U(unsigned j, vector<unsigned> & sorted_active_rows) {
+void sparse_matrix<T, X>::process_index_in_dfs_for_y_U(unsigned j, vector<unsigned> & sorted_active_rows) {
     SASSERT(m_processed[j] == false);
-    m_processed[j]=true;
-    auto & row = m_rows[adjust_row(j)];
-    for (auto & c : row) {
-        unsigned i = adjust_column_inverse(c.m_index);
-        if (i == j) continue;
-        if (!m_processed[i]) {
-            process_index_recursively_for_y_U(i, sorted_active_rows);
+    SASSERT(m_dfs_stack.empty());
+    m_processed[j] = true;
+    m_dfs_stack.push_back(std::make_pair(j, 0u));
+    while (!m_dfs_stack.empty()) {
+        unsigned k = m_dfs_stack.back().first;
+        unsigned pos = m_dfs_stack.back().second;
+        auto & row = m_rows[adjust_row(k)];
+        unsigned next = UINT_MAX;
+        while (pos < row.size()) {
+            unsigned i = adjust_column_inverse(row[pos++].m_index);
+            if (i != k && !m_processed[i]) {
+                next = i;
+                break;
+            }
+        }
+        if (next == UINT_MAX) {
+            m_dfs_stack.pop_back();
+            sorted_active_rows.push_back(k);
+        } else {
+            m_dfs_stack.back().second = pos;
+            m_processed[next] = true;
+            m_dfs_stack.push_back(std::make_pair(next, 0u));
         }
     }
-    sorted_active_rows.push_back(j);
 }
 
 template <typename T, typename X>
-void sparse_matrix<T, X>::process_column_recursively(unsigned j, vector<unsigned> & sorted_active_rows) {
+void sparse_matrix<T, X>::process_column_in_dfs(unsigned j, vector<unsigned> & sorted_active_rows) {
     SASSERT(m_processed[j] == false);
-    auto & mc = m_columns[adjust_column(j)].m_values;
-    for (auto & iv : mc) {
-        unsigned i = adjust_row_inverse(iv.m_index);
-        if (i == j) continue;
-        if (!m_processed[i]) {
-            process_column_recursively(i, sorted_active_rows);
+    SASSERT(m_dfs_stack.empty());
+    m_dfs_stack.push_back(std::make_pair(j, 0u));
+    while (!m_dfs_stack.empty()) {
+        unsigned k = m_dfs_stack.back().first;
+        unsigned pos = m_dfs_stack.back().second;
+        auto & mc = m_columns[adjust_column(k)].m_values;
+        unsigned next = UINT_MAX;
+        while (pos < mc.size()) {
+            unsigned i = adjust_row_inverse(mc[pos++].m_index);
+            if (i != k && !m_processed[i]) {
+                next = i;
+                break;
+            }
+        }
+        if (next == UINT_MAX) {
+            m_dfs_stack.pop_back();
+            m_processed[k] = true;
+            sorted_active_rows.push_back(k);
+        } else {
+            m_dfs_stack.back().second = pos;
+            m_dfs_stack.push_back(std::make_pair(next, 0u));
         }
     }
-    m_processed[j]=true;
-    sorted_active_rows.push_back(j);
 }
 
 
@@ -652,7 +682,7 @@ template <typename T, typename X>
 void sparse_matrix<T, X>::create_graph_G(const vector<unsigned> & index_or_right_side, vector<unsigned> & sorted_active_rows) {
     for (auto i : index_or_right_side) {
         if (m_processed[i]) continue;
-        process_column_recursively(i, sorted_active_rows);
+        process_column_in_dfs(i, sorted_active_rows);
     }
 
     for (auto i : sorted_active_rows) {
@@ -665,7 +695,7 @@ template <typename T, typename X>
 void sparse_matrix<T, X>::extend_and_sort_active_rows(const vector<unsigned> & index_or_right_side, vector<unsigned> & sorted_active_rows) {
     for (auto i : index_or_right_side) {
         if (m_processed[i]) continue;
-        process_index_recursively_for_y_U(i, sorted_active_rows);
+        process_index_in_dfs_for_y_U(i, sorted_active_rows);
     }
 
     for (auto i : sorted_active_rows) {
@@ -110,7 +110,9 @@ public:
 
     void pivot(unsigned i, lp_settings & settings);
 
-    void pivot_row_to_row(unsigned i, unsigned row, lp_settings & settings);;
+    void pivot_row_to_row(unsigned i, unsigned row, lp_settings & settings);
+
+    void row_minus_multiple_of_row(unsigned row_offset, unsigned pivot_row_offset, unsigned begin, unsigned end, const T & m, lp_settings & settings);
 
     void divide_row_by_pivot(unsigned i);
 
@@ -74,10 +74,14 @@ template <typename T, typename X>    int square_dense_submatrix<T, X>::find_pivo
 
 template <typename T, typename X>    void square_dense_submatrix<T, X>::pivot(unsigned i, lp_settings & settings) {
     divide_row_by_pivot(i);
-    for (unsigned k = i + 1; k < m_parent->dimension(); k++)
+    unsigned pjd = adjust_column(i) - m_index_start;
+    for (unsigned k = i + 1; k < m_parent->dimension(); k++) {
+        // a row with zero in the pivot column does not change, and its L entry stays zero
+        if (is_zero(m_v[(k - m_index_start) * m_dim + pjd]))
+            continue;
         pivot_row_to_row(i, k, settings);
+    }
 }
-
 template <typename T, typename X>    void square_dense_submatrix<T, X>::pivot_row_to_row(unsigned i, unsigned row, lp_settings & settings) {
     SASSERT(i < row);
     unsigned pj = adjust_column(i); // the pivot column
@@ -88,20 +92,22 @@ template <typename T, typename X>    void square_dense_submatrix<T, X>::pivot_ro
     T m = m_v[row_offset + pjd];
     SASSERT(!is_zero(pivot));
     m_v[row_offset + pjd] = -m * pivot; // creating L matrix
-    for (unsigned j = m_index_start; j < m_parent->dimension(); j++) {
-        if (j == pj) {
-            pivot_row_offset++;
-            row_offset++;
-            continue;
-        }
-        auto t = m_v[row_offset] - m_v[pivot_row_offset] * m;
+    // the pivot column keeps the L entry, so the row is updated in two
+    // contiguous ranges around it
+    row_minus_multiple_of_row(row_offset, pivot_row_offset, 0, pjd, m, settings);
+    row_minus_multiple_of_row(row_offset, pivot_row_offset, pjd + 1, m_dim, m, settings);
+}
+
+template <typename T, typename X>    void square_dense_submatrix<T, X>::row_minus_multiple_of_row(unsigned row_offset, unsigned pivot_row_offset, unsigned begin, unsigned end, const T & m, lp_settings & settings) {
+    T * r = m_v.c_ptr() + row_offset;
+    const T * p = m_v.c_ptr() + pivot_row_offset;
+    for (unsigned j = begin; j < end; j++) {
+        T t = r[j] - p[j] * m;
         if (settings.abs_val_is_smaller_than_drop_tolerance(t)) {
-            m_v[row_offset] = zero_of_type<T>();
+            r[j] = zero_of_type<T>();
         } else {
-            m_v[row_offset] = t;
+            r[j] = t;
         }
-        row_offset++; pivot_row_offset++;
-        // at the same time we pivot the L too
     }
 }
 
@@ -219,28 +225,42 @@ void square_dense_submatrix<T, X>::apply_from_left_local(indexed_vector<L> & w,
 #endif // use indexed vector here
 
 #ifndef DO_NOT_USE_INDEX
-    vector<L> t(m_parent->dimension(), zero_of_type<L>());
+    // Only the rows of the dense block and the images of the indices outside of
+    // the block can become non-zero, so the work is proportional to the size of
+    // the index and of the block, not to the dimension of the matrix.
+    vector<L> block(m_dim, zero_of_type<L>());
+    vector<std::pair<unsigned, L>> outside;
+    bool block_is_touched = false;
     for (auto k : w.m_index) {
         unsigned j = adjust_column(k); // k-th element will contribute only to column j
-        if (j < m_index_start || j >= this->m_index_start +  this->m_dim) { // it is a unit matrix outside 
-            t[adjust_row_inverse(j)] = w[k];
+        if (j < m_index_start || j >= this->m_index_start +  this->m_dim) { // it is a unit matrix outside
+            outside.push_back(std::make_pair(adjust_row_inverse(j), w[k]));
         } else {
+            block_is_touched = true;
             const L & v = w[k];
-            for (unsigned i = 0; i < m_dim; i++) {
-                unsigned row = adjust_row_inverse(m_index_start + i);
-                unsigned offs = i * m_dim + j - m_index_start;
-                t[row] += m_v[offs] * v;
+            unsigned offs = j - m_index_start;
+            for (unsigned i = 0; i < m_dim; i++, offs += m_dim) {
+                block[i] += m_v[offs] * v;
             }
         }
     }
+    for (auto k : w.m_index)
+        w.m_data[k] = zero_of_type<L>();
     w.m_index.clear();
-    for (unsigned i = 0; i < m_parent->dimension(); i++) {
-        const L & v = t[i];
-        if (!settings.abs_val_is_smaller_than_drop_tolerance(v)){
-            w.m_index.push_back(i);
-            w.m_data[i] = v;
-        } else {
-            w.m_data[i] = zero_of_type<L>();
+    for (auto & p : outside) {
+        if (!settings.abs_val_is_smaller_than_drop_tolerance(p.second)) {
+            w.m_index.push_back(p.first);
+            w.m_data[p.first] = p.second;
+        }
+    }
+    if (block_is_touched) {
+        for (unsigned i = 0; i < m_dim; i++) {
+            const L & v = block[i];
+            if (!settings.abs_val_is_smaller_than_drop_tolerance(v)) {
+                unsigned row = adjust_row_inverse(m_index_start + i);
+                w.m_index.push_back(row);
+                w.m_data[row] = v;
+            }
         }
     }
 #else